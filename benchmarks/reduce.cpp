@@ -0,0 +1,84 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/parallel_numeric.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <execution>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace coasyncpp;
+
+/// @brief The function that starts a task and waits until it will be completed on the Scheduler.
+template <typename T> auto run(core::async<T> task) -> T
+{
+    task.execute();
+    while (!task.done())
+        std::this_thread::yield();
+
+    if constexpr (!std::is_void_v<T>)
+        return task.result();
+}
+
+/// @brief The function that measures the best time of the several runs of the function.
+/// @param name The parameter that represents the name of the measured algorithm.
+/// @param bytes The parameter that represents the count of the bytes the algorithm reads and writes.
+/// @param func The parameter that represents the function to measure. It returns the checksum of its result.
+template <typename F> auto measure(char const *name, std::size_t bytes, F func) -> void
+{
+    constexpr int runs{10};
+
+    double checksum{};
+    auto best = std::chrono::steady_clock::duration::max();
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        checksum = func();
+        best = std::min(best, std::chrono::steady_clock::now() - start);
+    }
+
+    auto seconds = std::chrono::duration<double>(best).count();
+    std::cout << std::left << std::setw(36) << name << std::right << std::fixed << std::setprecision(3) << std::setw(9)
+              << seconds * 1000 << "ms" << std::setw(9) << std::setprecision(1) << bytes / seconds / 1e9 << "GB/s"
+              << "  checksum " << std::setprecision(0) << checksum << std::endl;
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    std::size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 24;
+
+    std::vector<float> values(size);
+    std::mt19937 random{42};
+    std::uniform_real_distribution<float> distribution{0.0f, 1.0f};
+    std::generate(values.begin(), values.end(), [&]() { return distribution(random); });
+    std::vector<float> prefixes(size);
+
+    std::cout << "Elements: " << size << ", workers: " << Scheduler::getInstance()->workerCount() << std::endl;
+
+    auto bytes = size * sizeof(float);
+    measure("std::accumulate", bytes, [&]() { return std::accumulate(values.begin(), values.end(), 0.0f); });
+    measure("std::reduce(par_unseq)", bytes,
+        [&]() { return std::reduce(std::execution::par_unseq, values.begin(), values.end(), 0.0f); });
+    measure("coasyncpp::parallel_reduce", bytes, [&]() { return run(parallel_reduce(values, 0.0f)); });
+
+    measure("std::inclusive_scan", 2 * bytes, [&]() {
+        std::inclusive_scan(values.begin(), values.end(), prefixes.begin());
+        return prefixes.back();
+    });
+    measure("std::inclusive_scan(par_unseq)", 2 * bytes, [&]() {
+        std::inclusive_scan(std::execution::par_unseq, values.begin(), values.end(), prefixes.begin());
+        return prefixes.back();
+    });
+    measure("coasyncpp::parallel_inclusive_scan", 2 * bytes, [&]() {
+        run(parallel_inclusive_scan(values, prefixes.begin()));
+        return prefixes.back();
+    });
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,115 @@
+#include <coasyncpp/async.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using namespace coasyncpp;
+using namespace std::chrono_literals;
+
+std::atomic<int> served{};
+std::atomic<int> criticalServed{};
+
+/// @brief The function that burns the CPU for the given time.
+auto spin(std::chrono::steady_clock::duration duration) -> void
+{
+    auto until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until)
+        ;
+}
+
+/// @brief The coroutine that simulates the request.
+auto serve(bool isCritical) -> core::async<void>
+{
+    spin(200us);
+    ++served;
+    if (isCritical)
+        ++criticalServed;
+    co_return;
+}
+
+/// @brief The coroutine that admits itself to the Scheduler queue before it does the work.
+auto serveAdmitted(std::atomic<int> &failed) -> core::async<void>
+{
+    auto admitted = co_await admit(task_priority::background);
+    if (!admitted)
+    {
+        ++failed;
+        co_return;
+    }
+    spin(200us);
+    ++served;
+}
+
+/// @brief The coroutine that runs the task on the Scheduler worker.
+auto start(core::async<void> task) -> detached_task
+{
+    co_await task;
+}
+
+/// @brief Waits until the queue is drained.
+auto drain() -> void
+{
+    while (0 != Scheduler::getInstance()->stats().globalQueueDepth_)
+        std::this_thread::sleep_for(1ms);
+    std::this_thread::sleep_for(10ms);
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    auto scheduler = Scheduler::getInstance();
+    auto burst = 2000 * scheduler->workerCount();
+    auto capacity = 64 * scheduler->workerCount();
+
+    // Fails fast once the capacity is reached or the requests wait longer than 5ms for 20ms.
+    scheduler->setAdmission({capacity, overload_policy::reject, 5ms, 20ms});
+    int rejected{};
+    for (std::size_t i = 0; i < burst; ++i)
+    {
+        auto submitted = scheduler->submit(std::make_shared<core::async<void>>(serve(false)));
+        if (!submitted && overloadedErrorCode == submitted.error().code())
+            ++rejected;
+    }
+    drain();
+    std::cout << "Reject: " << served << " served, " << rejected << " rejected of " << burst << std::endl;
+
+    // Blocks the submitter until the queue has room.
+    served = 0;
+    scheduler->setAdmission({capacity, overload_policy::block});
+    for (std::size_t i = 0; i < burst / 4; ++i)
+        scheduler->submit(std::make_shared<core::async<void>>(serve(false)));
+    drain();
+    std::cout << "Block: " << served << " served of " << burst / 4 << std::endl;
+
+    // Sheds the background requests to admit the critical ones.
+    served = 0;
+    scheduler->setAdmission({capacity, overload_policy::shed_lowest});
+    int critical{};
+    for (std::size_t i = 0; i < burst; ++i)
+    {
+        auto priority = 0 == i % 32 ? task_priority::critical : task_priority::background;
+        critical += task_priority::critical == priority;
+        scheduler->submit(std::make_shared<core::async<void>>(serve(task_priority::critical == priority)), priority);
+    }
+    drain();
+    std::cout << "Shed lowest: " << criticalServed << " of " << critical << " critical served, " << served
+              << " served" << std::endl;
+
+    // The running coroutines admit themselves, the shed ones are resumed with the error.
+    served = 0;
+    std::atomic<int> failed{};
+    scheduler->setAdmission({capacity, overload_policy::shed_oldest});
+    for (int i = 0; i < 256; ++i)
+        start(serveAdmitted(failed));
+    while (256 != served + failed)
+        std::this_thread::sleep_for(1ms);
+    std::cout << "Shed oldest: " << served << " served, " << failed << " shed" << std::endl;
+
+    scheduler->setAdmission({});
+    scheduler->stats().dump(std::cout);
+
+    return EXIT_SUCCESS;
+}
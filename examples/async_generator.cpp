@@ -0,0 +1,123 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/async_generator.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace coasyncpp;
+
+/// @brief The global variable that represents pending page requests of the third party io library.
+std::queue<std::pair<int, std::coroutine_handle<>>> requestsQueue;
+/// @brief The global variable that represents a mutex guarding the requests queue.
+std::mutex requestsMutex;
+/// @brief The global variable thar inidicates does worker thread should countinue to run.
+std::atomic<bool> isRun{true};
+
+/// @brief The function that represents third party io library worker thread function.
+void ioWorker()
+{
+    while (isRun)
+    {
+        std::pair<int, std::coroutine_handle<>> request{};
+        {
+            std::lock_guard lock{requestsMutex};
+            if (!requestsQueue.empty())
+            {
+                request = requestsQueue.front();
+                requestsQueue.pop();
+            }
+        }
+
+        if (request.second)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            request.second.resume();
+        }
+        else
+            std::this_thread::yield();
+    }
+}
+
+/// @brief The class that represents an awaiter of the page fetched by the io library.
+class fetch_page_awaiter
+{
+  public:
+    fetch_page_awaiter(int page) : page_{page}
+    {
+    }
+    bool await_ready()
+    {
+        return false;
+    }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        std::lock_guard lock{requestsMutex};
+        requestsQueue.push({page_, handle});
+    }
+    std::vector<int> await_resume()
+    {
+        if (page_ > 3)
+            return {};
+
+        return {page_ * 10 + 1, page_ * 10 + 2, page_ * 10 + 3};
+    }
+
+  private:
+    int page_{};
+};
+
+/// @brief The async generator that streams rows of a paginated result set.
+/// @return Returns the next row fetched from the io library.
+auto rows() -> async_generator<int>
+{
+    for (int page = 1;; ++page)
+    {
+        std::vector<int> rows = co_await fetch_page_awaiter{page};
+        if (rows.empty())
+            co_return;
+
+        for (auto row : rows)
+            co_yield row;
+    }
+}
+
+/// @brief The coroutine that consumes rows one by one.
+auto consumeByNext() -> core::async<void>
+{
+    auto gen = rows();
+    while (auto row = co_await gen.next())
+        std::cout << "next: " << *row << std::endl;
+}
+
+/// @brief The coroutine that consumes rows via for co_await loop.
+auto consumeByForEach() -> core::async<void>
+{
+    co_await forEach(rows(), [](int row) { std::cout << "forEach: " << row << std::endl; });
+}
+
+/// @brief The function that starts a task and waits until it will be completed by the io thread.
+auto run(core::async<void> task) -> void
+{
+    task.execute();
+    while (!task.done())
+        std::this_thread::yield();
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    std::thread ioThread{ioWorker};
+
+    run(consumeByNext());
+    run(consumeByForEach());
+
+    isRun = false;
+    ioThread.join();
+
+    return EXIT_SUCCESS;
+}
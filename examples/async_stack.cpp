@@ -0,0 +1,79 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/async_stack.hpp>
+#include <coasyncpp/latch.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace coasyncpp;
+using namespace std::chrono_literals;
+
+// The coroutines are named by their source location with COASYNCPP_FRAME_STATS defined, otherwise by the module and the
+// offset of their resume functions.
+
+async_latch connected{1};
+async_latch cancelled{1};
+
+auto readRow(int id) -> expected::async<int>
+{
+    auto stack = co_await currentAsyncBacktrace();
+    std::cout << "The async backtrace of readRow:\n" << stack;
+
+    // Never connected until the main thread counts down, the watchdog reports the stall meanwhile.
+    co_await connected.wait();
+    co_return id * 10;
+}
+
+auto loadUser(int id) -> expected::async<int>
+{
+    auto row = co_await readRow(id);
+    co_return *row + 1;
+}
+
+auto handleRequest() -> core::async<void>
+{
+    auto user = co_await loadUser(42);
+    std::cout << "User: " << *user << std::endl;
+}
+
+auto pollQueue() -> expected::async<int>
+{
+    // Never counted down, the task is abandoned instead.
+    co_await cancelled.wait();
+    co_return 0;
+}
+
+auto handleQueue() -> core::async<void>
+{
+    co_await pollQueue();
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    progress_watchdog watchdog{100ms, std::cout};
+
+    auto task = handleRequest();
+    watchdog.watch(task);
+    task.execute();
+
+    std::this_thread::sleep_for(300ms);
+    std::cout << "The async backtrace of the stalled task:\n" << asyncBacktrace(task);
+
+    connected.countDown();
+    while (!task.done())
+        std::this_thread::yield();
+
+    {
+        // The task destroyed before it's complete is not watched anymore.
+        auto abandoned = handleQueue();
+        watchdog.watch(abandoned);
+        abandoned.execute();
+    }
+    std::this_thread::sleep_for(200ms);
+
+    std::cout << "Stalls reported: " << watchdog.stalls() << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+#include <coasyncpp/batch_generator.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <ranges>
+#include <string_view>
+
+using namespace coasyncpp;
+
+namespace stdv = std::ranges::views;
+
+/// @brief The coroutine that generates squares one by one.
+/// @param count The parameter that represents the count of numbers to generate.
+/// @return Returns the next square.
+auto squares(uint64_t count) -> generator<uint64_t>
+{
+    for (uint64_t n = 0; n < count; ++n)
+        co_yield n * n;
+}
+
+/// @brief The coroutine that generates squares in batches.
+/// @param count The parameter that represents the count of numbers to generate.
+/// @return Returns the next batch of squares.
+auto squaresBatched(uint64_t count) -> batch_generator<uint64_t>
+{
+    batch_buffer<uint64_t, 1024> batch{};
+
+    for (uint64_t first = 0; first < count; first += batch.capacity())
+    {
+        auto storage = batch.storage();
+        auto size = std::min<uint64_t>(batch.capacity(), count - first);
+
+        // The hot loop stays tight and vectorizable.
+        for (uint64_t i = 0; i < size; ++i)
+            storage[i] = (first + i) * (first + i);
+
+        batch.resize(size);
+        co_yield batch.span();
+    }
+}
+
+/// @brief The coroutine that splits a log into words in batches.
+/// @param log The parameter that represents the log text.
+/// @return Returns the next batch of words.
+auto words(std::string_view log) -> batch_generator<std::string_view>
+{
+    batch_buffer<std::string_view, 4> batch{};
+
+    for (auto word : log | stdv::split(' '))
+    {
+        batch.push_back(std::string_view{word.begin(), word.end()});
+        if (batch.full())
+        {
+            co_yield batch.span();
+            batch.clear();
+        }
+    }
+
+    if (!batch.empty())
+        co_yield batch.span();
+}
+
+/// @brief The function that measures the time of the sum over the range.
+template <typename R> auto measure(char const *name, R &&range) -> void
+{
+    auto start = std::chrono::steady_clock::now();
+    uint64_t sum{};
+    for (auto n : range)
+        sum += n;
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << name << ": " << sum << " in " << elapsed.count() << "us" << std::endl;
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    constexpr uint64_t count{10'000'000};
+
+    measure("Element-wise", squares(count));
+    measure("Batched", squaresBatched(count) | flatten);
+
+    // Batch-wise consumption keeps the consumer loop tight as well.
+    uint64_t sum{};
+    for (auto batch : squaresBatched(count))
+        sum = std::accumulate(batch.begin(), batch.end(), sum);
+    std::cout << "Batch-wise: " << sum << std::endl;
+
+    for (auto word : words("GET /index.html 200 GET /favicon.ico 404 POST /login 302") | flatten
+            | stdv::filter([](auto word) { return word.starts_with('/'); }))
+        std::cout << word << std::endl;
+
+    return EXIT_SUCCESS;
+}
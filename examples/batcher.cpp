@@ -0,0 +1,93 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/batcher.hpp>
+#include <coasyncpp/fan_out.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace coasyncpp;
+using namespace std::chrono_literals;
+
+std::atomic<int> roundTrips{};
+std::atomic<int> loadedKeys{};
+
+/// @brief The coroutine that simulates the single round trip to the downstream service loading many users.
+/// @param ids The parameter that represents the user ids.
+/// @return Returns the user names in the order of the ids.
+auto fetchUsers(std::span<int> ids) -> core::async<std::vector<std::string>>
+{
+    ++roundTrips;
+    loadedKeys += ids.size();
+    co_await delay(5ms);
+
+    std::vector<std::string> users{};
+    for (auto id : ids)
+        users.push_back("user" + std::to_string(id));
+
+    co_return users;
+}
+
+/// @brief The coroutine that simulates the request handler which needs the single user.
+auto handle(batcher<int, std::string> &users, int id) -> core::async<void>
+{
+    auto user = co_await users.load(id);
+    if (!user)
+        std::cout << "Failed to load the user " << id << ": " << user.error().what() << std::endl;
+    else if (*user != "user" + std::to_string(id))
+        std::cout << "Wrong user " << *user << " of " << id << std::endl;
+}
+
+/// @brief The coroutine that simulates the downstream service failing to load some of the users.
+auto fetchSomeUsers(std::span<int> ids) -> core::async<std::vector<std::string>>
+{
+    co_return std::vector<std::string>{"user" + std::to_string(ids.front())};
+}
+
+/// @brief The coroutine that handles many requests concurrently, the user loads are batched.
+auto handleAll() -> core::async<void>
+{
+    std::vector<int> ids{};
+    for (int i = 0; i < 100; ++i)
+        ids.push_back(i % 40);
+
+    batcher<int, std::string> perPass{fetchUsers};
+    auto handlePerPass = [&perPass](int id) { return handle(perPass, id); };
+    co_await for_each_async(ids, handlePerPass, 100);
+    std::cout << "100 loads of 40 users on the same pass: " << roundTrips << " round trip(s), " << loadedKeys
+              << " keys" << std::endl;
+
+    roundTrips = 0;
+    loadedKeys = 0;
+    batcher<int, std::string> windowed{fetchUsers, 2ms, 16};
+    auto handleWindowed = [&windowed](int id) { return handle(windowed, id); };
+    co_await for_each_async(ids, handleWindowed, 100);
+    std::cout << "100 loads of 40 users within 2ms, at most 16 keys per batch: " << roundTrips << " round trip(s), "
+              << loadedKeys << " keys" << std::endl;
+
+    // Every load of the batch fails rather than reads past the values.
+    batcher<int, std::string> failing{fetchSomeUsers};
+    auto handleFailing = [&failing](int id) { return handle(failing, id); };
+    std::vector<int> failingIds{1, 2};
+    co_await for_each_async(failingIds, handleFailing, 2);
+}
+
+/// @brief The function that starts a task and waits until it will be completed on the Scheduler.
+auto run(core::async<void> task) -> void
+{
+    task.execute();
+    while (!task.done())
+        std::this_thread::yield();
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    run(handleAll());
+
+    return EXIT_SUCCESS;
+}
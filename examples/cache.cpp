@@ -0,0 +1,86 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/cache.hpp>
+#include <coasyncpp/fan_out.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace coasyncpp;
+using namespace std::chrono_literals;
+
+using user_cache = async_cache<int, expected::expected_value_type<std::string>>;
+
+std::atomic<int> loads{};
+
+/// @brief The coroutine that simulates the slow user loading from the database.
+/// @param id The parameter that represents the user id, the negative ones don't exist.
+/// @return Returns the user name or the error.
+auto loadUser(int id) -> expected::async<std::string>
+{
+    ++loads;
+    co_await delay(10ms);
+
+    if (id < 0)
+        co_return std::unexpected(async_error{404, "No such user"});
+
+    co_return "user" + std::to_string(id);
+}
+
+/// @brief The coroutine that simulates the request handler reading the user through the cache.
+auto handle(user_cache &cache, int id) -> core::async<void>
+{
+    auto loader = [id]() { return loadUser(id); };
+    auto user = co_await cache.get(id, loader);
+    if (!user)
+        std::cout << "User " << id << ": " << user.error().what() << std::endl;
+}
+
+/// @brief The coroutine that shows the stampede protection, the expiration, the negative caching and the eviction.
+auto useCache() -> core::async<void>
+{
+    user_cache cache{4, 50ms, 20ms, 2};
+
+    // The hot key requested by many concurrent requests is loaded once.
+    std::vector<int> hot(200, 1);
+    auto handleOne = [&cache](int id) { return handle(cache, id); };
+    co_await for_each_async(hot, handleOne, 64);
+    std::cout << "200 concurrent requests of the hot key, loads: " << loads << std::endl;
+
+    co_await handle(cache, 1);
+    std::cout << "Cached, loads: " << loads << std::endl;
+
+    co_await delay(60ms);
+    co_await handle(cache, 1);
+    std::cout << "Expired, loads: " << loads << std::endl;
+
+    co_await handle(cache, -1);
+    co_await handle(cache, -1);
+    std::cout << "Error cached, loads: " << loads << std::endl;
+    co_await delay(30ms);
+    co_await handle(cache, -1);
+    std::cout << "Error expired, loads: " << loads << std::endl;
+
+    std::vector<int> many{10, 11, 12, 13, 14, 15, 16, 17};
+    co_await for_each_async(many, handleOne, 8);
+    std::cout << "Evicted to the capacity, size: " << cache.size() << std::endl;
+}
+
+/// @brief The function that starts a task and waits until it will be completed on the Scheduler.
+auto run(core::async<void> task) -> void
+{
+    task.execute();
+    while (!task.done())
+        std::this_thread::yield();
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    run(useCache());
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/fan_out.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace coasyncpp;
+using namespace std::chrono_literals;
+
+std::atomic<int> inFlight{};
+std::atomic<int> maxInFlight{};
+
+/// @brief The coroutine that simulates the call to some downstream service.
+/// @param id The parameter that represents the id of the requested record.
+/// @return Returns the record or the error for every 10th id.
+auto fetch(int id) -> expected::async<int>
+{
+    auto current = ++inFlight;
+    auto max = maxInFlight.load();
+    while (max < current && !maxInFlight.compare_exchange_weak(max, current))
+        ;
+
+    co_await delay(5ms);
+    --inFlight;
+
+    if (0 == id % 10)
+        co_return std::unexpected(async_error{404, "Not found"});
+
+    co_return id * id;
+}
+
+/// @brief The coroutine that fetches all the records, at most 8 at once.
+auto fetchAll(std::vector<int> const &ids) -> core::async<void>
+{
+    auto start = std::chrono::steady_clock::now();
+    auto records = co_await transform_async(ids, fetch, 8);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "Fetched " << records.size() << " records in " << elapsed.count() << "ms, at most " << maxInFlight
+              << " at once" << std::endl;
+    for (std::size_t i = 0; i < 12; ++i)
+    {
+        if (records[i])
+            std::cout << ids[i] << ": " << *records[i] << std::endl;
+        else
+            std::cout << ids[i] << ": " << records[i].error().what() << std::endl;
+    }
+
+    maxInFlight = 0;
+    co_await for_each_async(ids, fetch, 4);
+    std::cout << "Fetched again, at most " << maxInFlight << " at once" << std::endl;
+
+    // The call that throws instead of resulting in the error stops the rest and is rethrown to the awaiter.
+    auto fetchValid = [](int id) {
+        if (id > 50)
+            throw std::out_of_range{"The id is out of range."};
+        return fetch(id);
+    };
+    try
+    {
+        co_await transform_async(ids, fetchValid, 4);
+        std::cout << "Fetched all the valid ones" << std::endl;
+    }
+    catch (std::out_of_range const &e)
+    {
+        std::cout << "Failed to fetch: " << e.what() << std::endl;
+    }
+}
+
+/// @brief The function that starts a task and waits until it will be completed on the Scheduler.
+auto run(core::async<void> task) -> void
+{
+    task.execute();
+    while (!task.done())
+        std::this_thread::yield();
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    std::vector<int> ids(100);
+    std::iota(ids.begin(), ids.end(), 1);
+
+    run(fetchAll(ids));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/fork.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace coasyncpp;
+
+/// @brief The function that calculates the Fibonacci number recursively, below the grain size.
+auto serialFib(int n) -> uint64_t
+{
+    return n < 2 ? n : serialFib(n - 1) + serialFib(n - 2);
+}
+
+/// @brief The coroutine that calculates the Fibonacci number by the fork/join recursion.
+/// @param n The parameter that represents the index of the Fibonacci number.
+/// @return Returns the Fibonacci number.
+auto fib(int n) -> core::async<uint64_t>
+{
+    if (n < 20)
+        co_return serialFib(n);
+
+    auto left = fib(n - 1);
+    auto right = fib(n - 2);
+
+    // The left half may be stolen by an idle worker, while this one calculates the right half.
+    co_await fork(left);
+    co_await right;
+    co_await join();
+
+    co_return left.result() + right.result();
+}
+
+/// @brief The coroutine that sorts the values by the fork/join quicksort.
+/// @param values The parameter that represents the values to sort.
+auto quicksort(std::span<int> values) -> core::async<void>
+{
+    if (values.size() < 2048)
+    {
+        std::sort(values.begin(), values.end());
+        co_return;
+    }
+
+    auto pivot = values[values.size() / 2];
+    auto middle1 = std::partition(values.begin(), values.end(), [pivot](int value) { return value < pivot; });
+    auto middle2 = std::partition(middle1, values.end(), [pivot](int value) { return !(pivot < value); });
+
+    auto left = quicksort({values.begin(), middle1});
+    auto right = quicksort({middle2, values.end()});
+
+    co_await fork(left);
+    co_await right;
+    co_await join();
+}
+
+/// @brief The function that starts a task and waits until it will be completed on the Scheduler.
+template <typename Task> auto run(Task &task) -> void
+{
+    task.execute();
+    while (!task.done())
+        std::this_thread::yield();
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    using std::chrono::duration_cast, std::chrono::milliseconds;
+
+    auto start = std::chrono::steady_clock::now();
+    auto task = fib(36);
+    run(task);
+    std::cout << "fib(36) = " << task.result() << " in "
+              << duration_cast<milliseconds>(std::chrono::steady_clock::now() - start).count() << "ms" << std::endl;
+
+    std::vector<int> values(4'000'000);
+    std::mt19937 random{42};
+    std::generate(values.begin(), values.end(), random);
+
+    start = std::chrono::steady_clock::now();
+    auto sort = quicksort(values);
+    run(sort);
+    std::cout << "quicksort: " << (std::is_sorted(values.begin(), values.end()) ? "sorted" : "not sorted") << " in "
+              << duration_cast<milliseconds>(std::chrono::steady_clock::now() - start).count() << "ms" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,75 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/fan_out.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace coasyncpp;
+using namespace std::chrono_literals;
+
+// The target is built with COASYNCPP_FRAME_STATS defined, otherwise the frames are allocated as usual.
+
+/// @brief The coroutine with the large buffer living across the suspension point, so it's kept in the frame.
+auto bloated(int id) -> core::async<int>
+{
+    std::array<char, 4096> buffer{};
+    buffer[id % buffer.size()] = 1;
+
+    co_await delay(10ms);
+    co_return std::accumulate(buffer.begin(), buffer.end(), id);
+}
+
+auto lean(int id) -> core::async<int>
+{
+    co_await delay(10ms);
+    co_return id;
+}
+
+auto process(int id) -> core::async<int>
+{
+    auto result = 0 == id % 4 ? co_await bloated(id) : co_await lean(id);
+    co_return result;
+}
+
+auto processAll() -> core::async<void>
+{
+    std::vector<int> ids(10000);
+    std::iota(ids.begin(), ids.end(), 0);
+
+    auto results = co_await transform_async(ids, process, 2000);
+    std::cout << "Processed " << results.size() << " items" << std::endl;
+}
+
+/// @brief The function that starts a task and waits until it will be completed on the Scheduler.
+auto run(core::async<void> task) -> void
+{
+    task.execute();
+    while (!task.done())
+        std::this_thread::yield();
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+#ifdef COASYNCPP_FRAME_STATS
+    frames::dumpAtExit();
+#endif
+
+    run(processAll());
+
+#ifdef COASYNCPP_FRAME_STATS
+    auto taken = frames::snapshot();
+    std::cout << "High-water: " << taken.highWaterBytes_ / 1024 << "KiB" << std::endl;
+    for (auto const &site : taken.sites_)
+    {
+        std::cout << site.function_ << ": " << site.frameSize_ << " bytes, at most " << site.highWater_
+                  << " live, " << site.total_ << " total" << std::endl;
+    }
+#endif
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,113 @@
+#include <coasyncpp/generator.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <ranges>
+#include <string>
+#include <vector>
+
+using namespace coasyncpp;
+
+namespace stdv = std::ranges::views;
+
+/// @brief The structure that represents some large record which is expensive to copy.
+struct Record
+{
+    Record(int id) : id_{id}
+    {
+    }
+    Record(Record const &other) : id_{other.id_}, payload_{other.payload_}
+    {
+        ++copies;
+    }
+    Record(Record &&other) = default;
+
+    int id_{};
+    std::array<double, 512> payload_{};
+
+    static inline int copies{};
+};
+
+static_assert(std::ranges::input_range<generator<Record>>);
+static_assert(std::ranges::view<generator<Record>>);
+static_assert(std::same_as<std::ranges::range_reference_t<generator<Record>>, Record &&>);
+static_assert(std::same_as<std::ranges::range_reference_t<generator<Record const &>>, Record const &>);
+
+/// @brief The coroutine that generates records by moving them out of the frame.
+/// @param count The parameter that represents the count of records to generate.
+/// @return Returns the next record.
+auto records(int count) -> generator<Record>
+{
+    for (int id = 0; id < count; ++id)
+    {
+        Record record{id};
+        co_yield std::move(record);
+    }
+}
+
+/// @brief The coroutine that yields references to records stored in a table.
+/// @param table The parameter that represents the table of records.
+/// @return Returns the reference to the next record.
+auto scan(std::vector<Record> const &table) -> generator<Record const &>
+{
+    for (auto const &record : table)
+        co_yield record;
+}
+
+/// @brief The coroutine that generates a generator of the words per line.
+/// @return Returns the next line represented as a generator of its words.
+auto lines() -> generator<generator<std::string>>
+{
+    for (int line = 1; line <= 3; ++line)
+        co_yield [](int line) -> generator<std::string> {
+            for (int word = 1; word <= line; ++word)
+                co_yield "w" + std::to_string(line) + std::to_string(word);
+        }(line);
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    // Rvalue yields, chunked.
+#if defined(__cpp_lib_ranges_chunk)
+    for (auto chunk : records(10) | stdv::chunk(4))
+    {
+        for (Record const &record : chunk)
+            std::cout << std::setw(3) << record.id_;
+        std::cout << std::endl;
+    }
+#else
+    // No views::chunk in the standard library, e.g. libstdc++ 12, the records are grouped by hand.
+    std::size_t column{};
+    for (Record const &record : records(10))
+    {
+        std::cout << std::setw(3) << record.id_;
+        if (0 == ++column % 4)
+            std::cout << std::endl;
+    }
+    if (0 != column % 4)
+        std::cout << std::endl;
+#endif
+
+    // Reference yields through the filter/transform pipeline.
+    std::vector<Record> table{};
+    for (int id = 0; id < 10; ++id)
+        table.emplace_back(id);
+
+    for (auto id : scan(table)
+            | stdv::filter([](Record const &record) { return 0 == record.id_ % 3; })
+            | stdv::transform([](Record const &record) { return record.id_; }))
+        std::cout << std::setw(3) << id;
+    std::cout << std::endl;
+
+    // Nested generators flattened via join.
+    for (auto const &word : lines() | stdv::join)
+        std::cout << word << " ";
+    std::cout << std::endl;
+
+    std::cout << "Copies: " << Record::copies << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,67 @@
+#include <coasyncpp/async.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace coasyncpp;
+using namespace std::chrono_literals;
+
+std::atomic<int> done{};
+std::atomic<int> local{};
+
+/// @brief The function that burns the CPU for the given time.
+auto spin(std::chrono::steady_clock::duration duration) -> void
+{
+    auto until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until)
+        ;
+}
+
+/// @brief The coroutine that simulates the work on the data of the shard.
+auto part(std::size_t shard) -> detached_task
+{
+    spin(100us);
+    if (shard == Scheduler::getInstance()->currentShard())
+        ++local;
+    ++done;
+    co_return;
+}
+
+/// @brief The coroutine that moves to the shard and schedules the parts there.
+auto process(std::size_t shard, int parts) -> detached_task
+{
+    co_await resumeOnShard(shard);
+    // Scheduled from the worker, the parts go to its shard.
+    for (int i = 0; i < parts; ++i)
+        part(shard);
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    auto topology = detectTopology();
+    std::cout << "NUMA nodes:";
+    for (auto const &cpus : topology.nodes_)
+        std::cout << " " << cpus.size() << " CPUs";
+    std::cout << std::endl;
+
+    auto scheduler = Scheduler::getInstance();
+    std::cout << "Workers:";
+    for (auto const &worker : scheduler->stats().workers_)
+        std::cout << " " << worker.index_ << "@cpu" << worker.cpu_ << "/shard" << worker.shard_;
+    std::cout << std::endl;
+
+    int const parts = 200;
+    for (std::size_t shard = 0; shard < scheduler->shardCount(); ++shard)
+        process(shard, parts);
+
+    auto total = parts * static_cast<int>(scheduler->shardCount());
+    while (total != done)
+        std::this_thread::sleep_for(1ms);
+    std::cout << local << " of " << total << " parts ran on the workers of their shard" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/parallel.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace coasyncpp;
+
+/// @brief The function that represents some CPU heavy work which cost depends on the value.
+/// @param n The parameter that represents the upper bound.
+/// @return Returns the count of primes less than n.
+auto countPrimes(uint64_t n) -> uint64_t
+{
+    uint64_t count{};
+    for (uint64_t candidate = 2; candidate < n; ++candidate)
+    {
+        bool isPrime{true};
+        for (uint64_t divisor = 2; divisor * divisor <= candidate && isPrime; ++divisor)
+            isPrime = 0 != candidate % divisor;
+        count += isPrime;
+    }
+
+    return count;
+}
+
+/// @brief The coroutine that represents the CPU heavy stage of some request handler.
+auto handle(std::vector<uint64_t> const &bounds, std::vector<uint64_t> &primes) -> core::async<void>
+{
+    // Suspends the handler until all the chunks are done on the Scheduler workers.
+    co_await parallel_transform(bounds, primes.begin(), countPrimes);
+    co_await parallel_for_each(primes, [](uint64_t &count) { count *= 2; });
+}
+
+/// @brief The coroutine that validates the counts in parallel, the first invalid one fails the whole call.
+auto validate(std::vector<uint64_t> &primes) -> core::async<void>
+{
+    auto check = [](uint64_t &count) {
+        if (0 != count % 2)
+            throw std::invalid_argument{"The count of primes is not doubled."};
+    };
+
+    primes[primes.size() / 2] += 1;
+    try
+    {
+        co_await parallel_for_each(primes, check);
+        std::cout << "Validated" << std::endl;
+    }
+    catch (std::invalid_argument const &e)
+    {
+        std::cout << "Validation failed: " << e.what() << std::endl;
+    }
+}
+
+/// @brief The function that starts a task and waits until it will be completed on the Scheduler.
+auto run(core::async<void> task) -> void
+{
+    task.execute();
+    while (!task.done())
+        std::this_thread::yield();
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    std::vector<uint64_t> bounds(2000);
+    std::iota(bounds.begin(), bounds.end(), 1000);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint64_t> serial(bounds.size());
+    std::transform(bounds.begin(), bounds.end(), serial.begin(), [](uint64_t n) { return 2 * countPrimes(n); });
+    auto serialTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    std::vector<uint64_t> parallel(bounds.size());
+    run(handle(bounds, parallel));
+    auto parallelTime = std::chrono::steady_clock::now() - start;
+
+    using std::chrono::duration_cast, std::chrono::milliseconds;
+    std::cout << "Workers: " << Scheduler::getInstance()->workerCount() << std::endl;
+    std::cout << "Serial: " << std::accumulate(serial.begin(), serial.end(), uint64_t{}) << " in "
+              << duration_cast<milliseconds>(serialTime).count() << "ms" << std::endl;
+    std::cout << "Parallel: " << std::accumulate(parallel.begin(), parallel.end(), uint64_t{}) << " in "
+              << duration_cast<milliseconds>(parallelTime).count() << "ms" << std::endl;
+
+    // The exception of the function on any worker is rethrown to the awaiting coroutine.
+    run(validate(parallel));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,74 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/prefetch.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <ranges>
+#include <utility>
+
+using namespace coasyncpp::core;
+
+namespace stdv = std::ranges::views;
+
+/// @brief The function that simulates CPU bound work of the given duration.
+auto work(std::chrono::microseconds duration) -> void
+{
+    auto until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until)
+        ;
+}
+
+/// @brief The coroutine that represents the decode stage of some two-stage parser.
+/// @param count The parameter that represents the count of records to decode.
+/// @return Returns the next decoded record.
+auto decode(int count) -> async<int>
+{
+    for (int record = 1; record <= count; ++record)
+    {
+        work(std::chrono::microseconds{50});
+        co_yield record;
+    }
+}
+
+/// @brief The coroutine that represents the decode stage which waits for the input of every record.
+/// @param count The parameter that represents the count of records to decode.
+/// @return Returns the next decoded record.
+auto decodeReceived(int count) -> async<int>
+{
+    using namespace std::chrono_literals;
+
+    for (int record = 1; record <= count; ++record)
+    {
+        co_await coasyncpp::delay(100us);
+        co_yield record;
+    }
+}
+
+/// @brief The function that represents the process stage of the two-stage parser.
+template <typename R> auto process(char const *name, R &&records) -> void
+{
+    auto start = std::chrono::steady_clock::now();
+
+    long sum{};
+    for (auto record : std::forward<R>(records) | stdv::filter([](int record) { return 0 == record % 2; }))
+    {
+        work(std::chrono::microseconds{100});
+        sum += record;
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << name << ": " << sum << " in " << elapsed.count() << "ms" << std::endl;
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    // Lock-step: decoding runs only when the processing asks for the next record.
+    process("Lock-step", decode(2000));
+    // Pipelined: decoding runs up to 64 records ahead on the Scheduler worker.
+    process("Prefetch", prefetch(decode(2000), 64));
+    // The generator awaiting between its values is prefetched as well, every record exactly once.
+    process("Prefetch awaiting", prefetch(decodeReceived(200), 64));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+#include <coasyncpp/async.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace coasyncpp;
+using namespace std::chrono_literals;
+
+std::atomic<int> compacted{};
+std::atomic<int> handled{};
+std::atomic<long> maxLatency{};
+
+/// @brief The function that burns the CPU for the given time.
+auto spin(std::chrono::steady_clock::duration duration) -> void
+{
+    auto until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until)
+        ;
+}
+
+/// @brief The coroutine that simulates the compaction step.
+auto compact() -> core::async<void>
+{
+    spin(1ms);
+    ++compacted;
+    co_return;
+}
+
+/// @brief The coroutine that simulates the interactive request, in the critical lane or before its deadline.
+auto handle(std::chrono::steady_clock::time_point arrived, bool hasDeadline) -> core::async<void>
+{
+    if (hasDeadline)
+        co_await reschedule(arrived + 2ms);
+    else
+        co_await reschedule(task_priority::critical);
+
+    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - arrived);
+    auto max = maxLatency.load();
+    while (max < latency.count() && !maxLatency.compare_exchange_weak(max, latency.count()))
+        ;
+    spin(100us);
+    ++handled;
+}
+
+/// @brief The coroutine that runs the task on the Scheduler worker.
+auto start(core::async<void> task) -> detached_task
+{
+    co_await task;
+}
+
+/// @brief The coroutine that starts the compaction steps in the background lane, where they stay.
+auto compactor(int count) -> detached_task
+{
+    co_await reschedule(task_priority::background);
+    for (int i = 0; i < count; ++i)
+        start(compact());
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    // The backlog of the compaction keeps all the workers busy for a while.
+    auto backlog = 200 * static_cast<int>(Scheduler::getInstance()->workerCount());
+    compactor(backlog);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        std::this_thread::sleep_for(5ms);
+        start(handle(std::chrono::steady_clock::now(), 0 == i % 2));
+    }
+
+    while (handled < 20)
+        std::this_thread::yield();
+    std::cout << "Handled 20 requests while " << compacted << " of " << backlog
+              << " compaction steps were done, the max latency is " << maxLatency << "us" << std::endl;
+
+    while (compacted < backlog)
+        std::this_thread::yield();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,81 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/fan_out.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace coasyncpp;
+using namespace std::chrono_literals;
+
+// The target is built with COASYNCPP_PROFILING defined, otherwise the hooks are empty and nothing is accounted.
+
+/// @brief The function that burns some CPU time.
+auto spin(int count) -> int
+{
+    volatile int sum = 0;
+    for (int i = 0; i < count; ++i)
+        sum = sum + i % 7;
+
+    return sum;
+}
+
+/// @brief The coroutine that is accounted under the name of the task that created it, unless named itself.
+auto parse(int id) -> core::async<int>
+{
+    auto sum = spin(20000);
+    // The task may be resumed on another worker, the time is accounted anyway.
+    co_await delay(1ms);
+    co_return sum + spin(20000) + id;
+}
+
+auto render(int id) -> expected::async<int>
+{
+    co_await set_name("render");
+    co_await delay(1ms);
+    co_return spin(60000) + id;
+}
+
+auto handle(int id) -> core::async<int>
+{
+    co_await set_name("handle");
+    spin(5000);
+
+    auto parsed = co_await parse(id);
+    auto rendered = co_await render(id);
+    co_return parsed + *rendered;
+}
+
+auto handleAll() -> core::async<void>
+{
+    std::vector<int> ids(200);
+    std::iota(ids.begin(), ids.end(), 0);
+
+    auto results = co_await transform_async(ids, handle, 16);
+    // Named at creation rather than from within.
+    co_await parse(0).name("parse");
+
+    std::cout << "Handled " << results.size() << " requests" << std::endl;
+}
+
+/// @brief The function that starts a task and waits until it will be completed on the Scheduler.
+auto run(core::async<void> task) -> void
+{
+    task.execute();
+    while (!task.done())
+        std::this_thread::yield();
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    run(handleAll());
+
+#ifdef COASYNCPP_PROFILING
+    profile::dump(std::cout);
+#endif
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,81 @@
+#include <coasyncpp/generator.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace coasyncpp;
+
+/// @brief The structure that represents a node of some hierarchy, e.g. a config or a directory tree.
+struct Node
+{
+    std::string name_{};
+    std::vector<std::unique_ptr<Node>> children_{};
+};
+
+/// @brief The coroutine that walks the tree depth first.
+/// @param node The parameter that represents the root of the tree to walk.
+/// @param path The parameter that represents the path to the node.
+/// @return Returns the path of the next node.
+auto walk(Node const &node, std::string path = {}) -> generator<std::string>
+{
+    path += "/" + node.name_;
+    co_yield std::string{path};
+
+    for (auto const &child : node.children_)
+        co_yield elements_of(walk(*child, path));
+}
+
+/// @brief The coroutine that walks a degenerate tree (a chain) of the given depth.
+/// @param depth The parameter that represents the depth of the chain.
+/// @return Returns the depth of the next node.
+auto chain(int depth) -> generator<int>
+{
+    co_yield int{depth};
+
+    if (depth > 1)
+        co_yield elements_of(chain(depth - 1));
+}
+
+/// @brief The coroutine that yields leaves stored in a plain container.
+/// @return Returns the next leaf.
+auto leaves() -> generator<int>
+{
+    std::vector<int> values{1, 2, 3};
+    co_yield elements_of(values);
+    co_yield elements_of(chain(2));
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    Node root{"etc"};
+    root.children_.push_back(std::make_unique<Node>(Node{"nginx"}));
+    root.children_.back()->children_.push_back(std::make_unique<Node>(Node{"nginx.conf"}));
+    root.children_.back()->children_.push_back(std::make_unique<Node>(Node{"sites"}));
+    root.children_.push_back(std::make_unique<Node>(Node{"hosts"}));
+
+    for (auto const &path : walk(root))
+        std::cout << path << std::endl;
+
+    for (auto leaf : leaves())
+        std::cout << leaf << " ";
+    std::cout << std::endl;
+
+    // The cost of every element doesn't depend on its depth, so walking the chain is linear.
+    for (int depth : {1000, 10000, 100000})
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        long long sum{};
+        for (auto value : chain(depth))
+            sum += value;
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << "Depth " << depth << ": sum " << sum << " in " << elapsed.count() << "us" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
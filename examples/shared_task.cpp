@@ -0,0 +1,72 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/fan_out.hpp>
+#include <coasyncpp/shared_task.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace coasyncpp;
+using namespace std::chrono_literals;
+
+std::atomic<int> loads{};
+
+/// @brief The coroutine that simulates the slow config loading.
+/// @return Returns the config value.
+auto loadConfig() -> expected::async<std::string>
+{
+    ++loads;
+    co_await delay(20ms);
+
+    co_return "timeout=30s";
+}
+
+/// @brief The coroutine that simulates the request handler which depends on the config.
+/// @param config The parameter that represents the shared config loading.
+/// @param id The parameter that represents the request id.
+auto handle(shared_task<expected::expected_value_type<std::string>> config, int id) -> core::async<void>
+{
+    auto value = co_await config;
+    if (!value)
+        std::cout << "Request " << id << " failed: " << value.error().what() << std::endl;
+}
+
+/// @brief The coroutine that handles many requests concurrently, all of them waiting for the same config.
+auto handleAll() -> core::async<void>
+{
+    shared_task config{loadConfig()};
+
+    std::vector<int> ids(64);
+    std::iota(ids.begin(), ids.end(), 1);
+    auto handleOne = [config](int id) { return handle(config, id); };
+    co_await for_each_async(ids, handleOne, 16);
+
+    std::cout << "Handled " << ids.size() << " requests, the config \"" << config.result().value() << "\" loaded "
+              << loads << " time(s)" << std::endl;
+
+    shared_task warmUp{loadConfig()};
+    warmUp.start();
+    co_await delay(50ms);
+    std::cout << "Warmed up: " << std::boolalpha << warmUp.done() << ", loaded " << loads << " time(s)" << std::endl;
+    std::cout << "Awaited after warm up: " << (co_await warmUp).value() << std::endl;
+}
+
+/// @brief The function that starts a task and waits until it will be completed on the Scheduler.
+auto run(core::async<void> task) -> void
+{
+    task.execute();
+    while (!task.done())
+        std::this_thread::yield();
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    run(handleAll());
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,65 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/fork.hpp>
+#include <coasyncpp/slice_watchdog.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace coasyncpp;
+using namespace std::chrono_literals;
+
+/// @brief The function that burns the CPU for the given time.
+auto spin(std::chrono::steady_clock::duration duration) -> void
+{
+    auto until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until)
+        ;
+}
+
+auto quick(int id) -> core::async<int>
+{
+    co_return id;
+}
+
+/// @brief The coroutine that queues the quick children on its worker and then hogs the worker.
+auto hog() -> core::async<void>
+{
+    std::vector<core::async<int>> children{};
+    for (int i = 0; i < 8; ++i)
+        children.push_back(quick(i));
+    for (auto &child : children)
+        co_await fork(child);
+
+    // No suspension point for 200ms, the children wait unless stolen or migrated.
+    spin(200ms);
+    co_await join();
+
+    std::cout << "The hog is over" << std::endl;
+}
+
+/// @brief The coroutine that runs the task on the Scheduler worker.
+auto start(core::async<void> task) -> detached_task
+{
+    co_await task;
+}
+
+/// @brief The function that starts a task and waits until it will be completed on the Scheduler.
+auto run(core::async<void> task) -> void
+{
+    start(task);
+    while (!task.done())
+        std::this_thread::yield();
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    slice_watchdog watchdog{50ms, true, std::cout};
+
+    run(hog());
+    std::cout << "Run slices over the budget: " << watchdog.overruns() << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,56 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/fan_out.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace coasyncpp;
+using namespace std::chrono_literals;
+
+/// @brief The coroutine that simulates some work: the short computation and the wait for the timer.
+auto process(int id) -> core::async<int>
+{
+    auto sum = 0;
+    for (int i = 0; i < 10000 * (id % 4 + 1); ++i)
+        sum += i % 7;
+
+    co_await delay(1ms);
+    co_return sum;
+}
+
+auto processAll() -> core::async<void>
+{
+    std::vector<int> ids(1000);
+    std::iota(ids.begin(), ids.end(), 0);
+
+    auto sums = co_await transform_async(ids, process, 32);
+    std::cout << "Processed " << sums.size() << " items" << std::endl;
+}
+
+/// @brief The function that starts a task and waits until it will be completed on the Scheduler.
+auto run(core::async<void> task) -> void
+{
+    task.execute();
+    while (!task.done())
+        std::this_thread::yield();
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    run(processAll());
+
+    auto stats = Scheduler::getInstance()->stats();
+    stats.dump(std::cout);
+
+    // The histograms of the workers are added up for the whole Scheduler view.
+    duration_histogram::snapshot latency{};
+    for (auto const &worker : stats.workers_)
+        latency += worker.queueLatency_;
+    std::cout << "Queue latency p99: " << latency.percentile(0.99) / 1000 << "us" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,87 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/stream.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace coasyncpp;
+
+/// @brief The coroutine that represents a stream of some shard.
+/// @param shard The parameter that represents the shard number.
+/// @param count The parameter that represents the count of the values in the shard.
+/// @return Returns the next value of the shard.
+auto shard(int shard, int count) -> core::async<int>
+{
+    for (int i = 1; i <= count; ++i)
+        co_yield shard * 100 + i;
+}
+
+/// @brief The coroutine that represents a stream of some shard which waits for every value.
+/// @param shard The parameter that represents the shard number.
+/// @param count The parameter that represents the count of the values in the shard.
+/// @return Returns the next value of the shard.
+auto polledShard(int shard, int count) -> core::async<int>
+{
+    using namespace std::chrono_literals;
+
+    for (int i = 1; i <= count; ++i)
+    {
+        co_await delay(1ms);
+        co_yield shard * 100 + i;
+    }
+}
+
+/// @brief The async generator that represents a stream of names.
+/// @return Returns the next name.
+auto names() -> async_generator<std::string>
+{
+    for (auto name : {"alpha", "beta", "gamma"})
+        co_yield std::string{name};
+}
+
+/// @brief The coroutine that prints all the values of the stream.
+template <typename T> auto print(char const *name, async_generator<T> stream) -> core::async<void>
+{
+    std::cout << name << ":";
+    while (auto value = co_await stream.next())
+        std::cout << " " << *value;
+    std::cout << std::endl;
+}
+
+/// @brief The coroutine that prints all the zipped values.
+auto printZipped() -> core::async<void>
+{
+    auto zipped = zip(shard(1, 5), names());
+
+    std::cout << "zip:";
+    while (auto value = co_await zipped.next())
+        std::cout << " (" << std::get<0>(*value) << ", " << std::get<1>(*value) << ")";
+    std::cout << std::endl;
+}
+
+/// @brief The function that starts a task and waits until it will be completed on the Scheduler.
+auto run(core::async<void> task) -> void
+{
+    task.execute();
+    while (!task.done())
+        std::this_thread::yield();
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    auto shards = []() { return std::vector{shard(1, 3), shard(2, 3), shard(3, 3)}; };
+
+    run(print("merge", merge(shards(), 2)));
+    // The sources awaiting between their values stream every value once.
+    run(print("merge polled", merge(std::vector{polledShard(1, 3), polledShard(2, 3)}, 2)));
+    run(print("concat", concat(shards())));
+    run(print("interleave", interleave(shards())));
+    run(printZipped());
+
+    return EXIT_SUCCESS;
+}
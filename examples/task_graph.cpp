@@ -0,0 +1,78 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/task_graph.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace coasyncpp;
+using namespace std::chrono_literals;
+
+std::mutex logMutex{};
+
+/// @brief The coroutine that simulates the build step.
+/// @param name The parameter that represents the name of the step.
+/// @param inputs The parameter that represents the count of the inputs of the step.
+/// @return Returns the count of the steps done, including the inputs.
+auto step(std::string name, int inputs) -> core::async<int>
+{
+    {
+        std::lock_guard<std::mutex> lock{logMutex};
+        std::cout << name << " ";
+    }
+    co_await delay(10ms);
+
+    co_return inputs + 1;
+}
+
+/// @brief The coroutine that builds the graph: the long chain of the code generation and the many independent
+/// compilations, all of them linked together.
+auto build() -> core::async<void>
+{
+    task_graph graph{};
+
+    auto generate = graph.add([]() { return step("gen1", 0); });
+    for (int i = 2; i <= 4; ++i)
+        generate = graph.add([i](int inputs) { return step("gen" + std::to_string(i), inputs); }, generate);
+
+    std::vector<graph_node<int>> objects{};
+    for (int i = 1; i <= 8; ++i)
+        objects.push_back(graph.add([i]() { return step("cc" + std::to_string(i), 0); }));
+
+    auto link = graph.add(
+        [&objects](int generated) {
+            auto inputs = generated;
+            for (auto &object : objects)
+                inputs += object.result();
+
+            return step("link", inputs);
+        },
+        generate);
+    for (auto &object : objects)
+        graph.addDependency(link, object);
+
+    auto start = std::chrono::steady_clock::now();
+    co_await graph.run(2);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << std::endl << "Built " << link.result() << " steps in " << elapsed.count() << "ms" << std::endl;
+}
+
+/// @brief The function that starts a task and waits until it will be completed on the Scheduler.
+auto run(core::async<void> task) -> void
+{
+    task.execute();
+    while (!task.done())
+        std::this_thread::yield();
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    run(build());
+
+    return EXIT_SUCCESS;
+}
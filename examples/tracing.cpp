@@ -0,0 +1,54 @@
+#include <coasyncpp/async.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace coasyncpp;
+using namespace std::chrono_literals;
+
+// The target is built with COASYNCPP_TRACING defined, otherwise the hooks are empty and nothing is recorded.
+
+auto innerFunc(int value) -> expected::async<int>
+{
+    co_await delay(2ms);
+    co_return value * 2;
+}
+
+auto middleFunc(int value) -> expected::async<int>
+{
+    auto first = co_await innerFunc(value);
+    auto second = co_await innerFunc(value + 1);
+
+    co_return *first + *second;
+}
+
+auto outerFunc() -> core::async<void>
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        auto result = co_await middleFunc(i);
+        std::cout << "Result: " << *result << std::endl;
+    }
+}
+
+/// @brief The function that starts a task and waits until it will be completed on the Scheduler.
+auto run(core::async<void> task) -> void
+{
+    task.execute();
+    while (!task.done())
+        std::this_thread::yield();
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    run(outerFunc());
+
+#ifdef COASYNCPP_TRACING
+    trace::flush("trace.json");
+    std::cout << "Open trace.json in chrome://tracing or https://ui.perfetto.dev" << std::endl;
+#endif
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,79 @@
+#include <coasyncpp/async.hpp>
+#include <coasyncpp/window.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace coasyncpp;
+using namespace std::chrono_literals;
+
+/// @brief The async generator that represents records arriving in bursts.
+/// @param count The parameter that represents the count of the records.
+/// @param burst The parameter that represents the count of the records per burst.
+/// @return Returns the next record.
+auto records(int count, int burst) -> async_generator<int>
+{
+    for (int record = 1; record <= count; ++record)
+    {
+        co_yield record;
+        if (0 == record % burst)
+            co_await delay(20ms);
+    }
+}
+
+/// @brief The async generator that represents the text typed by a user, with pauses between the words.
+/// @return Returns the whole text typed so far.
+auto keystrokes() -> async_generator<std::string>
+{
+    std::string text{};
+    for (auto c : std::string{"hello world"})
+    {
+        text += c;
+        co_yield text;
+        co_await delay(' ' == c ? 50ms : 1ms);
+    }
+}
+
+/// @brief The coroutine that prints the sizes of all the batches.
+auto printBatches(char const *name, async_generator<std::vector<int>> batches) -> core::async<void>
+{
+    std::cout << name << ":";
+    while (auto batch = co_await batches.next())
+        std::cout << " [" << batch->front() << ".." << batch->back() << "]";
+    std::cout << std::endl;
+}
+
+/// @brief The coroutine that prints all the values of the stream.
+template <typename T> auto print(char const *name, async_generator<T> stream) -> core::async<void>
+{
+    std::cout << name << ":";
+    while (auto value = co_await stream.next())
+        std::cout << " \"" << *value << "\"";
+    std::cout << std::endl;
+}
+
+/// @brief The function that starts a task and waits until it will be completed on the Scheduler.
+auto run(core::async<void> task) -> void
+{
+    task.execute();
+    while (!task.done())
+        std::this_thread::yield();
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    // Fixed size batches.
+    run(printBatches("buffer_count", buffer_count(records(25, 25), 10)));
+    // Up to 8 records per batch, but the burst of 5 records isn't hold longer then 5ms.
+    run(printBatches("buffer_time", buffer_time(records(20, 5), 8, 5ms)));
+    // Only the text typed before the pause.
+    run(print("debounce", debounce(keystrokes(), 20ms)));
+    // At most one value per 30ms.
+    run(print("sample", sample(keystrokes(), 30ms)));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,69 @@
+#include <coasyncpp/async.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace coasyncpp;
+using namespace std::chrono_literals;
+
+std::mutex milestonesMutex{};
+std::string milestones{};
+
+/// @brief The coroutine that counts the numbers with no suspension points but the cooperative yield.
+/// @param name The parameter that represents the name of the counter in the milestones.
+/// @param count The parameter that represents the count of the numbers to count.
+auto count(char name, long count) -> core::async<long>
+{
+    long sum{};
+    for (long i = 0; i < count; ++i)
+    {
+        sum += i % 7;
+        if (0 == i % (count / 10))
+        {
+            std::lock_guard lock{milestonesMutex};
+            milestones += name;
+        }
+
+        // Continues inline unless the worker has been running it for longer than 1ms.
+        co_await yield_if_needed(1ms);
+    }
+
+    co_return sum;
+}
+
+/// @brief The coroutine that runs the task on the Scheduler worker.
+auto start(core::async<long> task) -> detached_task
+{
+    co_await task;
+}
+
+auto main(int argc, char *argv[]) -> int
+{
+    std::vector<core::async<long>> tasks{count('A', 20000000), count('B', 20000000), count('C', 20000000)};
+    for (auto &task : tasks)
+        start(task);
+
+    for (auto &task : tasks)
+    {
+        while (!task.done())
+            std::this_thread::yield();
+    }
+
+    // The counters progress together even on the single worker, rather than one after another.
+    std::cout << "Milestones: " << milestones << std::endl;
+
+    // The tasks whenAll() runs on the workers yield the same way, each resumes where it yielded exactly once.
+    milestones.clear();
+    std::vector<core::async<long>> stepped{count('D', 2000000), count('E', 2000000)};
+    auto all{whenAll(stepped)};
+    all.execute();
+    std::cout << "Milestones of whenAll: " << milestones << ", sums: " << stepped[0].result() << " "
+              << stepped[1].result() << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+#ifndef __COASYNCPP_ADMISSION_HPP__
+#define __COASYNCPP_ADMISSION_HPP__
+
+#include <chrono>
+#include <cstddef>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The code of the async_error the task is rejected or shed with when the Scheduler queue is overloaded.
+inline constexpr int overloadedErrorCode{503};
+
+/// @brief The enum that represents what the Scheduler does with the submitted task when its queue is overloaded.
+enum class overload_policy
+{
+    // Fails the submitted task.
+    reject,
+    // Blocks the submitting thread until the queue is not overloaded, rejects on the workers, which never block.
+    block,
+    // Sheds the task queued the longest to admit the submitted one.
+    shed_oldest,
+    // Sheds the task of the lowest priority class, not higher than the one of the submitted task.
+    shed_lowest
+};
+
+/// @brief The struct that represents the admission control of the tasks submitted to the Scheduler queue, both the
+/// capacity and the queue delay checks are off by default.
+struct admission_config
+{
+    // The count of the submitted tasks queued and not started yet, 0 is unbounded.
+    std::size_t capacity_{};
+    overload_policy policy_{overload_policy::reject};
+    // The queue delay the tasks may have persistently, 0 is unchecked.
+    std::chrono::steady_clock::duration target_{};
+    // The time the queue delay should stay over the target to mark the queue overloaded.
+    std::chrono::steady_clock::duration interval_{std::chrono::milliseconds{100}};
+};
+
+/// @brief The class that represents the CoDel-style detector of the standing queue: the queue is overloaded once the
+/// delay of every task dequeued for the interval is over the target, and it's not once the delay of any task is below
+/// the target or the queue is drained. The short bursts are absorbed, since they don't keep the delay over the target.
+/// It's not thread safe.
+class queue_delay_monitor
+{
+  public:
+    void configure(std::chrono::steady_clock::duration target, std::chrono::steady_clock::duration interval)
+    {
+        target_ = target;
+        interval_ = interval;
+        aboveSince_ = {};
+        isOverloaded_ = false;
+    }
+    /// @brief Accounts the delay of the task dequeued now.
+    /// @param isDrained The parameter that represents whether the queue is empty after the task is dequeued.
+    void onDequeue(std::chrono::steady_clock::duration delay, std::chrono::steady_clock::time_point now,
+        bool isDrained)
+    {
+        if (0 == target_.count())
+            return;
+
+        if (delay < target_ || isDrained)
+        {
+            aboveSince_ = {};
+            isOverloaded_ = false;
+        }
+        else if (std::chrono::steady_clock::time_point{} == aboveSince_)
+            aboveSince_ = now;
+        else if (now - aboveSince_ >= interval_)
+            isOverloaded_ = true;
+    }
+    bool isOverloaded() const
+    {
+        return isOverloaded_;
+    }
+
+  private:
+    std::chrono::steady_clock::duration target_{};
+    std::chrono::steady_clock::duration interval_{};
+    // The dequeue the delay is over the target since, the epoch if it's not.
+    std::chrono::steady_clock::time_point aboveSince_{};
+    bool isOverloaded_{};
+};
+} // namespace coasyncpp
+
+#endif
@@ -4,10 +4,13 @@
 #include "common.hpp"
 #include "scheduler.hpp"
 
+#include <atomic>
 #include <exception>
 #include <stdexcept>
 #include <coroutine>
 #include <iterator>
+#include <string_view>
+#include <utility>
 #include <expected>
 #include <vector>
 #include <cstring>
@@ -30,7 +33,7 @@ template <typename T> using expected_value_type = std::expected<T, async_error>;
 template <typename T> class async_iterator
 {
   public:
-    using iterator_category = std::forward_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
     using difference_type = int;
     using value_type = expected_value_type<T>;
     using pointer = expected_value_type<T> *;
@@ -42,7 +45,7 @@ template <typename T> class async_iterator
 
     expected_value_type<T> operator*() const
     {
-        return task_->value();
+        return task_->result();
     }
     async_iterator &operator++()
     {
@@ -78,7 +81,7 @@ template <typename T> class async_iterator
 
 template <typename T> bool operator==(async_iterator<T> const &lh, async_iterator<T> const &rh)
 {
-    return lh.value() == rh.value();
+    return lh.task_ == rh.task_;
 }
 template <typename T> bool operator!=(async_iterator<T> const &lh, async_iterator<T> const &rh)
 {
@@ -117,26 +120,34 @@ template <typename T> class async : public async_interface
 {
   public:
     // Promise type of the Self Result
-    struct promise_type
+    struct promise_type : task_profile, frame_allocator
     {
-        std::suspend_always initial_suspend()
+        promise_type()
         {
-            return {};
+            COASYNCPP_TRACE(create, std::coroutine_handle<promise_type>::from_promise(*this));
+            frame_.address_ = std::coroutine_handle<promise_type>::from_promise(*this).address();
+        }
+        ~promise_type()
+        {
+            COASYNCPP_TRACE(destroy, std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        auto initial_suspend()
+        {
+            return profiled(step_awaiter<initial_awaiter>{{}, isAtStep_});
         }
-        resume_awaiter<promise_type> final_suspend() noexcept
+        final_awaiter<promise_type> final_suspend() noexcept
         {
-            isDone_ = true;
             return {isFromStackCall_};
         }
         std::suspend_always return_value(expected_value_type<T> value)
         {
-            value_ = value;
+            value_ = std::move(value);
             return {};
         }
-        std::suspend_always yield_value(expected_value_type<T> value)
+        auto yield_value(expected_value_type<T> value)
         {
-            value_ = value;
-            return {};
+            value_ = std::move(value);
+            return profiled(step_awaiter<std::suspend_always>{{}, isAtStep_});
         }
         // void return_void() { isDone_ = true; }
         void unhandled_exception()
@@ -166,7 +177,11 @@ template <typename T> class async : public async_interface
         expected_value_type<T> value_{};
         std::coroutine_handle<> callerHandle_{};
         bool isFromStackCall_{true};
-        bool isDone_{};
+        std::atomic<bool> isDone_{};
+        // Suspended at the point execute() resumes the task at.
+        std::atomic<bool> isAtStep_{};
+        fork_state forks_{};
+        async_frame frame_{};
     };
 
     // Awaiter members
@@ -174,11 +189,16 @@ template <typename T> class async : public async_interface
     {
         return false;
     }
-    void await_suspend(std::coroutine_handle<> callerHandle)
+    template <typename P> std::coroutine_handle<> await_suspend(std::coroutine_handle<P> callerHandle)
     {
         selfHandle_->promise().callerHandle_ = callerHandle;
         selfHandle_->promise().isFromStackCall_ = false;
-        selfHandle_->resume();
+        // The caller of another kind, e.g. the detached task, ends the chain of the async backtrace.
+        if constexpr (requires { callerHandle.promise().frame_; })
+            callerHandle.promise().frame_.push(&selfHandle_->promise().frame_);
+        COASYNCPP_TRACE(suspend, callerHandle);
+        // Symmetric transfer, so a loop of the synchronously completed calls doesn't grow the stack.
+        return *selfHandle_;
     }
     expected_value_type<T> await_resume()
     {
@@ -201,13 +221,41 @@ template <typename T> class async : public async_interface
 
     void execute() override
     {
-        if (!selfHandle_->done())
-            selfHandle_->resume();
+        // The task suspended elsewhere is resumed by whatever it awaits.
+        resumeAtStep(*selfHandle_);
     }
     bool done() override
     {
         return selfHandle_->promise().isDone_;
     }
+    /// @brief Returns true if the task is suspended at the point execute() resumes it at, i.e. it's not started yet or
+    /// it's at co_yield, so its result is the value yielded. Otherwise it's running or awaiting something else.
+    bool atStep() const
+    {
+        return selfHandle_->promise().isAtStep_.load(std::memory_order_acquire);
+    }
+    /// @brief Names the task, its run time is accounted under the name when COASYNCPP_PROFILING is defined.
+    async &name(std::string_view name)
+    {
+        selfHandle_->promise().rename(name);
+        return *this;
+    }
+    /// @brief Returns the link of the task in the chain of the tasks awaiting each other, see async_stack.hpp.
+    async_frame &stackFrame()
+    {
+        return selfHandle_->promise().frame_;
+    }
+    async_frame *taskFrame() override
+    {
+        return &stackFrame();
+    }
+    /// @brief Makes the task the forked child of the task with the given fork state.
+    /// @return Returns the coroutine to spawn.
+    std::coroutine_handle<> fork(fork_state *parent)
+    {
+        selfHandle_->promise().forks_.parent_ = parent;
+        return *selfHandle_;
+    }
 
     async_iterator<T> begin()
     {
@@ -242,15 +290,23 @@ template <> class async<void> : public async_interface
 {
   public:
     // Promise type of the Self Result
-    struct promise_type
+    struct promise_type : task_profile, frame_allocator
     {
-        std::suspend_always initial_suspend()
+        promise_type()
         {
-            return {};
+            COASYNCPP_TRACE(create, std::coroutine_handle<promise_type>::from_promise(*this));
+            frame_.address_ = std::coroutine_handle<promise_type>::from_promise(*this).address();
+        }
+        ~promise_type()
+        {
+            COASYNCPP_TRACE(destroy, std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        auto initial_suspend()
+        {
+            return profiled(step_awaiter<initial_awaiter>{{}, isAtStep_});
         }
-        resume_awaiter<promise_type> final_suspend() noexcept
+        final_awaiter<promise_type> final_suspend() noexcept
         {
-            isDone_ = true;
             return {isFromStackCall_};
         }
         std::suspend_always return_void()
@@ -284,7 +340,11 @@ template <> class async<void> : public async_interface
         expected_value_type<void> value_{};
         std::coroutine_handle<> callerHandle_;
         bool isFromStackCall_{true};
-        bool isDone_{};
+        std::atomic<bool> isDone_{};
+        // Suspended at the point execute() resumes the task at.
+        std::atomic<bool> isAtStep_{};
+        fork_state forks_{};
+        async_frame frame_{};
     };
 
     // Awaiter members
@@ -292,11 +352,16 @@ template <> class async<void> : public async_interface
     {
         return false;
     }
-    void await_suspend(std::coroutine_handle<> callerHandle)
+    template <typename P> std::coroutine_handle<> await_suspend(std::coroutine_handle<P> callerHandle)
     {
         selfHandle_->promise().callerHandle_ = callerHandle;
         selfHandle_->promise().isFromStackCall_ = false;
-        selfHandle_->resume();
+        // The caller of another kind, e.g. the detached task, ends the chain of the async backtrace.
+        if constexpr (requires { callerHandle.promise().frame_; })
+            callerHandle.promise().frame_.push(&selfHandle_->promise().frame_);
+        COASYNCPP_TRACE(suspend, callerHandle);
+        // Symmetric transfer, so a loop of the synchronously completed calls doesn't grow the stack.
+        return *selfHandle_;
     }
     void await_resume()
     {
@@ -318,13 +383,41 @@ template <> class async<void> : public async_interface
 
     void execute() override
     {
-        if (!selfHandle_->done())
-            selfHandle_->resume();
+        // The task suspended elsewhere is resumed by whatever it awaits.
+        resumeAtStep(*selfHandle_);
     }
     bool done() override
     {
         return selfHandle_->promise().isDone_;
     }
+    /// @brief Returns true if the task is suspended at the point execute() resumes it at, i.e. it's not started yet or
+    /// it's at co_yield, so its result is the value yielded. Otherwise it's running or awaiting something else.
+    bool atStep() const
+    {
+        return selfHandle_->promise().isAtStep_.load(std::memory_order_acquire);
+    }
+    /// @brief Names the task, its run time is accounted under the name when COASYNCPP_PROFILING is defined.
+    async &name(std::string_view name)
+    {
+        selfHandle_->promise().rename(name);
+        return *this;
+    }
+    /// @brief Returns the link of the task in the chain of the tasks awaiting each other, see async_stack.hpp.
+    async_frame &stackFrame()
+    {
+        return selfHandle_->promise().frame_;
+    }
+    async_frame *taskFrame() override
+    {
+        return &stackFrame();
+    }
+    /// @brief Makes the task the forked child of the task with the given fork state.
+    /// @return Returns the coroutine to spawn.
+    std::coroutine_handle<> fork(fork_state *parent)
+    {
+        selfHandle_->promise().forks_.parent_ = parent;
+        return *selfHandle_;
+    }
     operator bool() const
     {
         return selfHandle_->promise().value_.has_value();
@@ -346,7 +439,7 @@ template <> class async<void> : public async_interface
 template <typename T> async<void> whenAll(std::vector<async<T>> tasks)
 {
     for (auto &task : tasks)
-        Scheduler::getInstance()->schedule(&task);
+        Scheduler::getInstance()->schedule(std::make_shared<async<T>>(task));
 
     for (auto &task : tasks)
     {
@@ -360,7 +453,7 @@ template <typename T> async<void> whenAll(std::vector<async<T>> tasks)
 template <typename T> async<void> whenAny(std::vector<async<T>> tasks)
 {
     for (auto &task : tasks)
-        Scheduler::getInstance()->schedule(&task);
+        Scheduler::getInstance()->schedule(std::make_shared<async<T>>(task));
 
     while (true)
     {
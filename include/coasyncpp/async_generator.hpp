@@ -0,0 +1,134 @@
+#ifndef __COASYNCPP_ASYNC_GENERATOR_HPP__
+#define __COASYNCPP_ASYNC_GENERATOR_HPP__
+
+#include "common.hpp"
+#include "async_core.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <utility>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+template <typename T> class async_generator;
+
+/// @brief The class that represents an awaiter of the next async generator value.
+/// @tparam T The type of the generated values.
+template <typename T> class async_generator_next_awaiter
+{
+  public:
+    using promise_type = typename async_generator<T>::promise_type;
+
+    async_generator_next_awaiter(std::coroutine_handle<promise_type> selfHandle) : selfHandle_{selfHandle}
+    {
+    }
+
+    bool await_ready() noexcept
+    {
+        return selfHandle_.promise().isDone_;
+    }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> callerHandle) noexcept
+    {
+        // Symmetric transfer into the producer. It transfers back on the next co_yield or on completion.
+        selfHandle_.promise().callerHandle_ = callerHandle;
+        return selfHandle_;
+    }
+    std::optional<T> await_resume()
+    {
+        auto &promise = selfHandle_.promise();
+
+        if (promise.exception_)
+            std::rethrow_exception(std::exchange(promise.exception_, nullptr));
+
+        if (promise.isDone_)
+            return std::nullopt;
+
+        return std::exchange(promise.value_, std::nullopt);
+    }
+
+  private:
+    std::coroutine_handle<promise_type> selfHandle_{};
+};
+
+/// @brief The class that represents async generator. Unlike the async<T> generator it may co_await between the
+/// yields, so the consumer receives values via co_await gen.next() and never blocks its thread.
+/// @tparam T The type of the generated values.
+template <typename T> class async_generator
+{
+  public:
+    // Promise type of the Self Result
+    struct promise_type : frame_allocator
+    {
+        std::suspend_always initial_suspend()
+        {
+            return {};
+        }
+        resume_awaiter<promise_type> final_suspend() noexcept
+        {
+            isDone_ = true;
+            return {false};
+        }
+        resume_awaiter<promise_type> yield_value(T value)
+        {
+            value_ = std::move(value);
+            return {false};
+        }
+        void return_void()
+        {
+        }
+        void unhandled_exception()
+        {
+            exception_ = std::current_exception();
+        }
+        auto get_return_object()
+        {
+            return async_generator<T>(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::optional<T> value_{};
+        std::exception_ptr exception_{};
+        std::coroutine_handle<> callerHandle_{};
+        bool isDone_{};
+    };
+
+    // Members
+    async_generator(std::coroutine_handle<promise_type> selfHandle) :
+        selfHandle_{new std::coroutine_handle<promise_type>{selfHandle},
+        [](std::coroutine_handle<promise_type> *handlePtr)
+        {
+            handlePtr->destroy();
+            delete handlePtr;
+        }}
+    {
+    }
+
+    /// @brief Resumes the producer up to the next co_yield.
+    /// @return Returns the awaiter which resumes with the next value or with std::nullopt when out of values.
+    async_generator_next_awaiter<T> next()
+    {
+        return {*selfHandle_};
+    }
+    bool done() const
+    {
+        return selfHandle_->promise().isDone_;
+    }
+
+  protected:
+  private:
+    std::shared_ptr<std::coroutine_handle<promise_type>> selfHandle_{};
+};
+
+/// @brief The coroutine that represents for co_await loop over the async generator.
+/// @param gen The parameter that represents the async generator to iterate over.
+/// @param func The parameter that represents the function to call for an every generated value.
+template <typename T, typename F> core::async<void> forEach(async_generator<T> gen, F func)
+{
+    while (auto value = co_await gen.next())
+        func(*value);
+}
+} // namespace coasyncpp
+
+#endif
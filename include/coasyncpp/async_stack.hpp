@@ -0,0 +1,250 @@
+#ifndef __COASYNCPP_ASYNC_STACK_HPP__
+#define __COASYNCPP_ASYNC_STACK_HPP__
+
+#include "common.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#define COASYNCPP_HAS_DLADDR
+#endif
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The struct that represents the entry of the async backtrace, the suspended task awaiting the previous one.
+struct async_stack_entry
+{
+    void const *address_{};
+    std::string function_{};
+};
+
+/// @brief The type that represents the async backtrace, the innermost task first.
+using async_stack = std::vector<async_stack_entry>;
+
+/// @brief Returns the module and the offset of the code, e.g. of the resume function of the coroutine, which is the
+/// local symbol, to symbolize offline, e.g. with addr2line -f -C -e module offset.
+inline std::string symbolizeCode(void const *code)
+{
+#ifdef COASYNCPP_HAS_DLADDR
+    Dl_info info{};
+    if (0 == dladdr(code, &info) || nullptr == info.dli_fname)
+        return {};
+
+    std::ostringstream out{};
+    out << info.dli_fname << "+0x" << std::hex
+        << (reinterpret_cast<std::uintptr_t>(code) - reinterpret_cast<std::uintptr_t>(info.dli_fbase));
+    return out.str();
+#else
+    return {};
+#endif
+}
+
+/// @brief Returns the name of the coroutine function of the frame with its source location if the frames are
+/// accounted, see frames.hpp, otherwise the module and the offset of its resume function.
+inline std::string symbolize(void const *address)
+{
+#ifdef COASYNCPP_FRAME_STATS
+    auto allocated = *reinterpret_cast<frames::site *const *>(static_cast<std::byte const *>(address) -
+                                                               __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    return allocated->function_ + " at " + allocated->file_ + ":" + std::to_string(allocated->line_);
+#else
+    // The frame of GCC, Clang and MSVC starts with the pointer to the resume function.
+    return symbolizeCode(*reinterpret_cast<void *const *>(address));
+#endif
+}
+
+/// @brief Captures the async backtrace from the frame up through its callers.
+inline async_stack captureAsyncStack(async_frame const *leaf)
+{
+    async_stack captured{};
+    for (auto frame = leaf; nullptr != frame; frame = frame->caller_)
+        captured.push_back({frame->address_, symbolize(frame->address_)});
+
+    return captured;
+}
+
+/// @brief Captures the async backtrace of the task, from the innermost task it awaits. Unless the task is watched by
+/// the progress_watchdog, the task should be suspended, so the chain doesn't change during the capture. Costs nothing
+/// until called.
+/// @param task The parameter that represents the async task of any flavour.
+template <typename Task> async_stack asyncBacktrace(Task &task)
+{
+    auto &base = task.stackFrame();
+
+    std::unique_lock<std::mutex> lock{};
+    if (nullptr != base.root_)
+        lock = std::unique_lock<std::mutex>{base.root_->mutex_};
+
+    auto leaf = &base;
+    while (nullptr != leaf->callee_)
+        leaf = leaf->callee_;
+
+    return captureAsyncStack(leaf);
+}
+
+/// @brief The class that represents an awaiter which captures the async backtrace of the current task and continues it
+/// inline.
+class backtrace_awaiter
+{
+  public:
+    bool await_ready() noexcept
+    {
+        return false;
+    }
+    template <typename P> bool await_suspend(std::coroutine_handle<P> handle)
+    {
+        // The callers are suspended awaiting the current task, their links don't change.
+        captured_ = captureAsyncStack(&handle.promise().frame_);
+        return false;
+    }
+    async_stack await_resume()
+    {
+        return std::move(captured_);
+    }
+
+  private:
+    async_stack captured_{};
+};
+
+/// @brief Captures the async backtrace of the current task, it should be awaited by the async task of any flavour.
+inline backtrace_awaiter currentAsyncBacktrace()
+{
+    return {};
+}
+
+/// @brief Writes the async backtrace, one task per line.
+inline std::ostream &operator<<(std::ostream &out, async_stack const &stack)
+{
+    for (std::size_t i = 0; i < stack.size(); ++i)
+    {
+        out << "#" << i << " " << stack[i].address_ << " in "
+            << (stack[i].function_.empty() ? "??" : stack[i].function_) << "\n";
+    }
+
+    return out;
+}
+
+/// @brief The class that represents the watchdog of the tasks which make no progress, i.e. neither call nor return
+/// from any async task in their chain, for longer than the threshold. It writes the async backtrace of every stalled
+/// task once per stall. The watchdog should outlive the watched tasks.
+class progress_watchdog
+{
+  public:
+    /// @brief Starts the watchdog thread.
+    /// @param threshold The parameter that represents the time without progress the task is reported after.
+    /// @param out The parameter that represents the stream to report to.
+    progress_watchdog(std::chrono::steady_clock::duration threshold, std::ostream &out = std::cerr) :
+        threshold_{threshold}, out_{out}
+    {
+        thread_ = std::thread{[this]() { run(); }};
+    }
+    ~progress_watchdog()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            isRunning_ = false;
+        }
+        cv_.notify_one();
+        thread_.join();
+    }
+    progress_watchdog(progress_watchdog const &) = delete;
+    progress_watchdog &operator=(progress_watchdog const &) = delete;
+
+    /// @brief Watches the task and the tasks it awaits, should be called before the task is started. The task is watched
+    /// until it's complete or destroyed.
+    /// @param task The parameter that represents the async task of any flavour.
+    template <typename Task> void watch(Task &task)
+    {
+        auto watched = std::make_unique<entry>();
+        watched->root_.base_ = &task.stackFrame();
+        watched->progressAt_ = std::chrono::steady_clock::now();
+        task.stackFrame().root_ = &watched->root_;
+
+        std::lock_guard<std::mutex> lock{mutex_};
+        entries_.push_back(std::move(watched));
+    }
+    /// @brief Returns the count of the stalls reported so far.
+    std::size_t stalls() const
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return stalls_;
+    }
+
+  private:
+    /// @brief The struct that represents the watched task.
+    struct entry
+    {
+        async_stack_root root_{};
+        std::uint64_t progress_{};
+        std::chrono::steady_clock::time_point progressAt_{};
+        bool isReported_{};
+    };
+
+    void run()
+    {
+        auto interval = std::max<std::chrono::steady_clock::duration>(threshold_ / 4, std::chrono::milliseconds{1});
+
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (!cv_.wait_for(lock, interval, [this]() { return !isRunning_; }))
+        {
+            auto now = std::chrono::steady_clock::now();
+            std::erase_if(entries_, [this, now](auto &watched) { return check(*watched, now); });
+        }
+    }
+    /// @brief Reports the task if it's stalled.
+    /// @return Returns true if the task is complete and is not watched anymore.
+    bool check(entry &watched, std::chrono::steady_clock::time_point now)
+    {
+        std::lock_guard<std::mutex> lock{watched.root_.mutex_};
+        if (watched.root_.isDone_)
+            return true;
+
+        if (watched.root_.progress_ != watched.progress_)
+        {
+            watched.progress_ = watched.root_.progress_;
+            watched.progressAt_ = now;
+            watched.isReported_ = false;
+        }
+        else if (!watched.isReported_ && now - watched.progressAt_ >= threshold_)
+        {
+            auto leaf = watched.root_.base_;
+            while (nullptr != leaf->callee_)
+                leaf = leaf->callee_;
+
+            auto stalled = std::chrono::duration_cast<std::chrono::milliseconds>(now - watched.progressAt_);
+            out_ << "Async task made no progress for " << stalled.count() << "ms:\n" << captureAsyncStack(leaf);
+            out_.flush();
+            watched.isReported_ = true;
+            ++stalls_;
+        }
+
+        return false;
+    }
+
+    std::chrono::steady_clock::duration threshold_{};
+    std::ostream &out_;
+    mutable std::mutex mutex_{};
+    std::condition_variable cv_{};
+    bool isRunning_{true};
+    std::vector<std::unique_ptr<entry>> entries_{};
+    std::size_t stalls_{};
+    std::thread thread_{};
+};
+} // namespace coasyncpp
+
+#endif
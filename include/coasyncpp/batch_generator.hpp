@@ -0,0 +1,81 @@
+#ifndef __COASYNCPP_BATCH_GENERATOR_HPP__
+#define __COASYNCPP_BATCH_GENERATOR_HPP__
+
+#include "generator.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <utility>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The type that represents generator which yields elements in batches. One resume produces the whole batch,
+/// so the cost of the resume is amortized over the batch size.
+/// @tparam T The type of the batch elements.
+template <typename T> using batch_generator = generator<std::span<T>>;
+
+/// @brief The view adaptor that flattens batches back into the element-wise range, e.g. gen | flatten.
+inline constexpr auto flatten = std::views::join;
+
+/// @brief The class that represents a fixed size buffer placed in the coroutine frame to collect the batch.
+/// @tparam T The type of the batch elements.
+/// @tparam N The capacity of the batch.
+template <typename T, std::size_t N> class batch_buffer
+{
+  public:
+    /// @brief Appends the value, the buffer should not be full, i.e. the full batch is yielded and cleared first.
+    void push_back(T value)
+    {
+        assert(size_ < N);
+        values_[size_++] = std::move(value);
+    }
+    void clear()
+    {
+        size_ = 0;
+    }
+
+    bool empty() const
+    {
+        return 0 == size_;
+    }
+    bool full() const
+    {
+        return N == size_;
+    }
+    std::size_t size() const
+    {
+        return size_;
+    }
+    static constexpr std::size_t capacity()
+    {
+        return N;
+    }
+
+    /// @brief Returns the whole underlying storage, so a hot loop may fill it directly and then resize().
+    std::span<T, N> storage()
+    {
+        return values_;
+    }
+    void resize(std::size_t size)
+    {
+        assert(size <= N);
+        size_ = size;
+    }
+
+    /// @brief Returns the collected batch. It stays valid until the buffer is cleared or refilled.
+    std::span<T> span()
+    {
+        return {values_.data(), size_};
+    }
+
+  private:
+    std::array<T, N> values_{};
+    std::size_t size_{};
+};
+} // namespace coasyncpp
+
+#endif
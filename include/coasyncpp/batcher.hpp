@@ -0,0 +1,170 @@
+#ifndef __COASYNCPP_BATCHER_HPP__
+#define __COASYNCPP_BATCHER_HPP__
+
+#include "common.hpp"
+#include "scheduler.hpp"
+#include "async_core.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The code of the async_error the loads of the batch result in if the batch function fails.
+inline constexpr int loadFailedErrorCode{502};
+
+/// @brief The class that represents the DataLoader-style batcher. The keys loaded within the window, or on the same
+/// Scheduler pass if the window is zero, are coalesced into the single call of the batch function, the duplicated keys
+/// are loaded once. The batch function results in the values in the order of the keys, if it throws or results in the
+/// other count of the values every load of the batch results in the async_error with the loadFailedErrorCode.
+/// @tparam K The type of the key.
+/// @tparam V The type of the value, e.g. std::expected<T, E> for the errors of the particular keys.
+/// @tparam Hash The type of the key hash.
+template <typename K, typename V, typename Hash = std::hash<K>> class batcher
+{
+  public:
+    using batch_function = std::function<core::async<std::vector<V>>(std::span<K>)>;
+
+    /// @brief The class that represents an awaiter which adds the key to the current batch and suspends until the
+    /// batch is loaded. It is the node of the batch, living in the frame of the awaiting coroutine.
+    class load_awaiter
+    {
+      public:
+        load_awaiter(batcher &owner, K key) : owner_{owner}, key_{std::move(key)}
+        {
+        }
+        bool await_ready() noexcept
+        {
+            return false;
+        }
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            handle_ = handle;
+            owner_.add(this);
+        }
+        std::expected<V, async_error> await_resume()
+        {
+            return std::move(*value_);
+        }
+
+      private:
+        friend class batcher;
+
+        batcher &owner_;
+        K key_;
+        std::size_t index_{};
+        std::coroutine_handle<> handle_{};
+        std::optional<std::expected<V, async_error>> value_{};
+    };
+
+    /// @brief Makes the batcher.
+    /// @param function The parameter that represents the batch function.
+    /// @param window The parameter that represents the time the keys are collected for, the keys are collected until
+    /// the next Scheduler pass if zero.
+    /// @param maxBatch The parameter that represents the maximal count of the keys in the batch, the full batch is
+    /// loaded at once.
+    batcher(batch_function function, std::chrono::steady_clock::duration window = {},
+        std::size_t maxBatch = std::numeric_limits<std::size_t>::max()) :
+        function_{std::move(function)}, window_{window}, maxBatch_{maxBatch}
+    {
+        assert(maxBatch_ > 0);
+    }
+    batcher(batcher const &) = delete;
+    batcher &operator=(batcher const &) = delete;
+
+    /// @brief Loads the value of the key within the batch. The batcher should outlive the loads.
+    load_awaiter load(K key)
+    {
+        return {*this, std::move(key)};
+    }
+
+  private:
+    /// @brief The struct that represents the keys collected so far and their waiters.
+    struct batch
+    {
+        std::vector<K> keys_{};
+        std::unordered_map<K, std::size_t, Hash> indices_{};
+        std::vector<load_awaiter *> waiters_{};
+        std::atomic_flag isTaken_{};
+    };
+
+    void add(load_awaiter *waiter)
+    {
+        std::shared_ptr<batch> full{};
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (!current_)
+            {
+                current_ = std::make_shared<batch>();
+                run(current_, window_);
+            }
+
+            auto [found, isNew] = current_->indices_.try_emplace(waiter->key_, current_->keys_.size());
+            if (isNew)
+                current_->keys_.push_back(waiter->key_);
+            waiter->index_ = found->second;
+            current_->waiters_.push_back(waiter);
+
+            if (current_->keys_.size() >= maxBatch_)
+                full = std::move(current_);
+        }
+
+        // The full batch doesn't wait for the window, its timer finds it taken.
+        if (full)
+            run(std::move(full), {});
+    }
+
+    /// @brief The coroutine that loads the batch once the window is over and resumes its waiters on the Scheduler.
+    detached_task run(std::shared_ptr<batch> loaded, std::chrono::steady_clock::duration window)
+    {
+        if (window > std::chrono::steady_clock::duration::zero())
+            co_await delay(window);
+
+        if (loaded->isTaken_.test_and_set())
+            co_return;
+
+        {
+            // No more keys are added to the batch.
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (current_ == loaded)
+                current_.reset();
+        }
+
+        std::vector<V> values = co_await function_(std::span<K>{loaded->keys_});
+        // The core::async of the throwing batch function results in no values.
+        auto isLoaded = values.size() == loaded->keys_.size();
+
+        for (auto waiter : loaded->waiters_)
+        {
+            if (isLoaded)
+                waiter->value_.emplace(std::in_place, values[waiter->index_]);
+            else
+                waiter->value_.emplace(std::unexpect, loadFailedErrorCode, "The batch function failed to load.");
+            // The waiter is gone as soon as its coroutine is resumed.
+            Scheduler::getInstance()->spawn(waiter->handle_);
+        }
+    }
+
+    batch_function function_;
+    std::chrono::steady_clock::duration window_{};
+    std::size_t maxBatch_{};
+    std::mutex mutex_{};
+    std::shared_ptr<batch> current_{};
+};
+} // namespace coasyncpp
+
+#endif
@@ -0,0 +1,180 @@
+#ifndef __COASYNCPP_CACHE_HPP__
+#define __COASYNCPP_CACHE_HPP__
+
+#include "common.hpp"
+#include "async_core.hpp"
+#include "shared_task.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The trait that tells whether the type is std::expected, i.e. the result of the expected or variant flavour.
+template <typename T> struct is_expected : std::false_type
+{
+};
+template <typename T, typename E> struct is_expected<std::expected<T, E>> : std::true_type
+{
+};
+
+/// @brief The class that represents the single-flight cache of the async loaded values. The concurrent loads of the
+/// same key are deduplicated into one shared task, the loaded values are kept for the TTL in the size-bounded LRU
+/// order. The keys are spread over the shards, every one with its own lock.
+/// @tparam K The type of the key.
+/// @tparam V The type of the value, i.e. the result of co_await on the loader task, e.g. std::expected<T, E>.
+/// @tparam Hash The type of the key hash.
+template <typename K, typename V, typename Hash = std::hash<K>> class async_cache
+{
+  public:
+    using clock = std::chrono::steady_clock;
+
+    /// @brief Makes the cache.
+    /// @param capacity The parameter that represents the maximal count of the values, spread evenly over the shards.
+    /// @param ttl The parameter that represents the time the loaded value is kept for.
+    /// @param negativeTtl The parameter that represents the time the error of std::expected is kept for, the errors
+    /// aren't cached if zero.
+    /// @param shards The parameter that represents the count of the shards.
+    async_cache(std::size_t capacity, clock::duration ttl, clock::duration negativeTtl = {}, std::size_t shards = 16) :
+        shards_(std::max<std::size_t>(1, shards)), shardCapacity_{std::max<std::size_t>(1, capacity / shards_.size())},
+        ttl_{ttl}, negativeTtl_{negativeTtl}
+    {
+    }
+    async_cache(async_cache const &) = delete;
+    async_cache &operator=(async_cache const &) = delete;
+
+    /// @brief Gets the value of the key, loading it if it isn't cached or expired. The concurrent gets of the same key
+    /// share the single load. The cache should outlive the loads.
+    /// @param key The parameter that represents the key.
+    /// @param loader The parameter that represents the function which returns the async task of any flavour loading
+    /// the value. It is called only on the miss.
+    /// @return Returns the shared task to co_await, the hit is ready without suspension.
+    template <typename Loader> shared_task<V> get(K const &key, Loader &&loader)
+    {
+        auto &shard = shardOf(key);
+        auto now = clock::now();
+
+        std::lock_guard<std::mutex> lock{shard.mutex_};
+        if (auto found = shard.index_.find(key); found != shard.index_.end())
+        {
+            auto entry = found->second;
+            if (entry->expiresAt_ > now)
+            {
+                shard.entries_.splice(shard.entries_.begin(), shard.entries_, entry);
+                return entry->task_;
+            }
+
+            shard.index_.erase(found);
+            shard.entries_.erase(entry);
+        }
+
+        auto id = ++shard.lastId_;
+        shared_task<V> task{load(shard, key, id, std::invoke(std::forward<Loader>(loader)))};
+        shard.entries_.push_front({key, task, id, clock::time_point::max()});
+        shard.index_.emplace(key, shard.entries_.begin());
+
+        while (shard.entries_.size() > shardCapacity_)
+        {
+            // The waiters of the evicted loading entry keep its shared task.
+            shard.index_.erase(shard.entries_.back().key_);
+            shard.entries_.pop_back();
+        }
+
+        return task;
+    }
+    /// @brief Removes the key, the next get loads it again.
+    void invalidate(K const &key)
+    {
+        auto &shard = shardOf(key);
+
+        std::lock_guard<std::mutex> lock{shard.mutex_};
+        if (auto found = shard.index_.find(key); found != shard.index_.end())
+        {
+            shard.entries_.erase(found->second);
+            shard.index_.erase(found);
+        }
+    }
+    /// @brief Returns the count of the cached and loading values.
+    std::size_t size()
+    {
+        std::size_t size{};
+        for (auto &shard : shards_)
+        {
+            std::lock_guard<std::mutex> lock{shard.mutex_};
+            size += shard.entries_.size();
+        }
+
+        return size;
+    }
+
+  private:
+    /// @brief The struct that represents the cached or loading value.
+    struct entry
+    {
+        K key_;
+        shared_task<V> task_;
+        std::uint64_t id_{};
+        clock::time_point expiresAt_{};
+    };
+
+    /// @brief The struct that represents the part of the keys with its own lock, the entries are in the LRU order.
+    struct alignas(64) shard
+    {
+        std::mutex mutex_{};
+        std::list<entry> entries_{};
+        std::unordered_map<K, typename std::list<entry>::iterator, Hash> index_{};
+        std::uint64_t lastId_{};
+    };
+
+    shard &shardOf(K const &key)
+    {
+        return shards_[Hash{}(key) % shards_.size()];
+    }
+
+    /// @brief The coroutine that awaits the loader and sets the expiration of the loaded entry.
+    template <typename Task> core::async<V> load(shard &shard, K key, std::uint64_t id, Task task)
+    {
+        V value = co_await task;
+
+        auto ttl = ttl_;
+        if constexpr (is_expected<V>::value)
+        {
+            if (!value.has_value())
+                ttl = negativeTtl_;
+        }
+
+        std::lock_guard<std::mutex> lock{shard.mutex_};
+        // The entry may be evicted, invalidated or replaced meanwhile.
+        if (auto found = shard.index_.find(key); found != shard.index_.end() && found->second->id_ == id)
+        {
+            if (ttl > clock::duration::zero())
+                found->second->expiresAt_ = clock::now() + ttl;
+            else
+            {
+                shard.entries_.erase(found->second);
+                shard.index_.erase(found);
+            }
+        }
+
+        co_return value;
+    }
+
+    std::vector<shard> shards_;
+    std::size_t shardCapacity_{};
+    clock::duration ttl_{};
+    clock::duration negativeTtl_{};
+};
+} // namespace coasyncpp
+
+#endif
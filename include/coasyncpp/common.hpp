@@ -1,18 +1,34 @@
 #ifndef __COASYNCPP_COMMON_HPP__
 #define __COASYNCPP_COMMON_HPP__
 
+#include <atomic>
 #include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <stdexcept>
 #include <cstring>
+#include <utility>
+
+#include "tracing.hpp"
+#include "profiling.hpp"
+#include "frames.hpp"
 
 namespace coasyncpp
 {
+struct async_frame;
+
 /// @brief The interface that represents asyc task interface.
 class async_interface
 {
   public:
     virtual void execute() = 0;
     virtual bool done() = 0;
+    /// @brief Returns the link of the task in the chain of the tasks awaiting each other, null if it's not linked.
+    virtual async_frame *taskFrame()
+    {
+        return nullptr;
+    }
     virtual ~async_interface() { }
 };
 
@@ -37,6 +53,9 @@ class async_error : public std::runtime_error
     int code_{};
 };
 
+/// @brief The type that represents result of co_await on the async task of any flavour, e.g. std::expected<T, E>.
+template <typename Task> using await_result_t = decltype(std::declval<Task &>().await_resume());
+
 /// @brief The class that represents out of values sentinel.
 struct async_sentinel
 {
@@ -69,6 +88,186 @@ template <typename T> class resume_awaiter
     bool isFromStackCall_{};
 };
 
+/// @brief The struct that represents the fork/join state of the async task: the count of its running forked children
+/// plus one for the task itself, the task waiting in join and the task it was forked from.
+struct fork_state
+{
+    /// @brief Marks the forked child complete.
+    /// @return Returns the joined parent to resume, if it was the last running child.
+    std::coroutine_handle<> complete() noexcept
+    {
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            return joiner_;
+
+        return std::noop_coroutine();
+    }
+
+    std::atomic<std::size_t> pending_{1};
+    std::coroutine_handle<> joiner_{};
+    fork_state *parent_{};
+};
+
+struct async_stack_root;
+
+/// @brief The struct that represents the link of the async task in the chain of the tasks awaiting each other, to
+/// capture the async backtrace. The links are plain pointers unless the chain is watched, see async_stack.hpp.
+struct async_frame
+{
+    /// @brief Links the frame of the awaited task under this one.
+    void push(async_frame *callee) noexcept;
+    /// @brief Unlinks the frame of the complete task from its caller.
+    void pop() noexcept;
+    /// @brief Unlinks the frame of the task destroyed before it's complete, if any.
+    ~async_frame();
+
+    void *address_{};
+    async_frame *caller_{};
+    async_frame *callee_{};
+    // The root of the watched chain, it guards the links.
+    async_stack_root *root_{};
+};
+
+/// @brief The struct that represents the root of the chain of the tasks watched for progress, every call and return
+/// within the chain is the progress.
+struct async_stack_root
+{
+    std::mutex mutex_{};
+    async_frame *base_{};
+    std::uint64_t progress_{};
+    bool isDone_{};
+};
+
+inline void async_frame::push(async_frame *callee) noexcept
+{
+    callee->caller_ = this;
+    callee->root_ = root_;
+    if (nullptr == root_)
+    {
+        callee_ = callee;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock{root_->mutex_};
+    callee_ = callee;
+    ++root_->progress_;
+}
+inline void async_frame::pop() noexcept
+{
+    std::unique_lock<std::mutex> lock{};
+    if (nullptr != root_)
+        lock = std::unique_lock<std::mutex>{root_->mutex_};
+
+    if (nullptr != caller_)
+        caller_->callee_ = nullptr;
+    // The tasks it awaits, if they outlive it, are not linked nor watched anymore.
+    if (nullptr != callee_)
+        callee_->caller_ = nullptr;
+    for (auto callee = std::exchange(callee_, nullptr); nullptr != callee; callee = callee->callee_)
+        callee->root_ = nullptr;
+
+    if (nullptr != root_)
+    {
+        ++root_->progress_;
+        // The root is released by the watchdog once it's done, so it's not touched afterwards.
+        if (this == root_->base_)
+            root_->isDone_ = true;
+    }
+    caller_ = nullptr;
+    root_ = nullptr;
+}
+inline async_frame::~async_frame()
+{
+    pop();
+}
+
+/// @brief The class that represents the awaiter of the point execute() resumes the task at, i.e. the initial one and
+/// the one of co_yield. The task is marked suspended there only once it's suspended, so execute() never resumes the
+/// task suspended elsewhere, e.g. awaiting the timer, whoever resumes it then.
+/// @tparam Awaiter The type of the wrapped awaiter.
+template <typename Awaiter> class step_awaiter
+{
+  public:
+    step_awaiter(Awaiter awaiter, std::atomic<bool> &isAtStep) : wrapped_{std::move(awaiter)}, isAtStep_{isAtStep}
+    {
+    }
+    bool await_ready() noexcept
+    {
+        return false;
+    }
+    void await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        wrapped_.await_suspend(handle);
+        // The task may be resumed by another thread as soon as it's marked, the awaiter is not touched after that.
+        isAtStep_.store(true, std::memory_order_release);
+    }
+    void await_resume() noexcept
+    {
+        // Resumed by execute() or by the awaiting task.
+        isAtStep_.store(false, std::memory_order_relaxed);
+        wrapped_.await_resume();
+    }
+
+  private:
+    Awaiter wrapped_;
+    std::atomic<bool> &isAtStep_;
+};
+
+/// @brief Resumes the task at the point execute() resumes it at, if it's suspended there.
+/// @return Returns true if the task is resumed.
+template <typename P> bool resumeAtStep(std::coroutine_handle<P> handle)
+{
+    if (!handle.promise().isAtStep_.exchange(false, std::memory_order_acquire))
+        return false;
+
+    handle.resume();
+    return true;
+}
+
+/// @brief The class that represents final awaiter of the async task. It marks the task done only once the coroutine is
+/// suspended, so the thread which observes done() may safely destroy the coroutine.
+/// @tparam T The type of the promise.
+template <typename T> class final_awaiter
+{
+  public:
+    final_awaiter(bool isFromStackCall) : isFromStackCall_{isFromStackCall}
+    {
+    }
+    bool await_ready() noexcept
+    {
+        return false;
+    }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<T> selfHandle) noexcept
+    {
+        COASYNCPP_TRACE(complete, selfHandle);
+        COASYNCPP_PROFILE_LEAVE();
+        selfHandle.promise().frame_.pop();
+
+        // The forked task is owned by its parent, which doesn't touch it until the join.
+        if (auto parent = selfHandle.promise().forks_.parent_)
+        {
+            selfHandle.promise().isDone_ = true;
+            return parent->complete();
+        }
+
+        std::coroutine_handle<> nextHandle = std::noop_coroutine();
+        if (!isFromStackCall_)
+        {
+            nextHandle = selfHandle.promise().callerHandle_;
+            COASYNCPP_TRACE(resume, nextHandle);
+        }
+
+        // The coroutine frame, including this awaiter, must not be touched after it is marked done.
+        selfHandle.promise().isDone_ = true;
+        return nextHandle;
+    }
+    void await_resume() noexcept
+    {
+    }
+
+  private:
+    bool isFromStackCall_{};
+};
+
 void coroutineHandleDestroyer(std::coroutine_handle<> handle)
 {
   handle.destroy();
@@ -0,0 +1,203 @@
+#ifndef __COASYNCPP_FAN_OUT_HPP__
+#define __COASYNCPP_FAN_OUT_HPP__
+
+#include "common.hpp"
+#include "scheduler.hpp"
+#include "async_core.hpp"
+#include "latch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The class that represents the state of the calls shared by all the lanes. Every lane keeps one call in
+/// flight and takes the next index as soon as its call is complete.
+/// @tparam Call The type of the function which starts the call for the given index.
+/// @tparam Result The type of the call result to collect, void to drop the results.
+template <typename Call, typename Result> class in_flight_calls
+{
+  public:
+    in_flight_calls(std::size_t size, std::size_t lanes, Call call) : call_{std::move(call)}, size_{size}, latch_{lanes}
+    {
+        if constexpr (!std::is_void_v<Result>)
+            results_.resize(size);
+    }
+
+    std::size_t next()
+    {
+        return next_.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::size_t size() const
+    {
+        return size_;
+    }
+    auto call(std::size_t index)
+    {
+        return call_(index);
+    }
+    template <typename R> void set(std::size_t index, R &&result)
+    {
+        results_[index].emplace(std::forward<R>(result));
+    }
+    void fail(std::exception_ptr exception)
+    {
+        if (!failed_.test_and_set())
+            exception_ = exception;
+
+        // No new calls are started.
+        next_.store(size_, std::memory_order_relaxed);
+    }
+    /// @brief Marks the lane done. The last one resumes the awaiting coroutine on the Scheduler.
+    void done()
+    {
+        latch_.countDown();
+    }
+    async_latch::awaiter join()
+    {
+        return latch_.wait();
+    }
+    /// @brief Returns the first exception of the calls, null if none.
+    std::exception_ptr exception() const
+    {
+        return exception_;
+    }
+    /// @brief Returns the results in the order of the indices.
+    std::vector<Result> results()
+    {
+        std::vector<Result> results{};
+        results.reserve(size_);
+        for (auto &result : results_)
+            results.push_back(std::move(*result));
+
+        return results;
+    }
+
+  private:
+    Call call_;
+    std::size_t size_{};
+    std::atomic<std::size_t> next_{};
+    async_latch latch_;
+    std::atomic_flag failed_{};
+    std::exception_ptr exception_{};
+    std::conditional_t<std::is_void_v<Result>, std::monostate, std::vector<std::optional<Result>>> results_{};
+};
+
+/// @brief The coroutine that represents the single lane of the calls. It awaits the calls one by one.
+template <typename Call, typename Result> detached_task runInFlight(std::shared_ptr<in_flight_calls<Call, Result>> calls)
+{
+    try
+    {
+        for (auto index = calls->next(); index < calls->size(); index = calls->next())
+        {
+            if constexpr (std::is_void_v<Result>)
+                co_await calls->call(index);
+            else
+                calls->set(index, co_await calls->call(index));
+        }
+    }
+    catch (...)
+    {
+        calls->fail(std::current_exception());
+    }
+
+    calls->done();
+}
+
+/// @brief Starts the lanes making the calls for every index of [0, size), at most maxInFlight of them at once.
+template <typename Result, typename Call>
+std::shared_ptr<in_flight_calls<Call, Result>> startInFlight(std::size_t size, Call call, std::size_t maxInFlight)
+{
+    assert(maxInFlight > 0);
+
+    auto lanes = std::min(size, maxInFlight);
+    auto calls = std::make_shared<in_flight_calls<Call, Result>>(size, lanes, std::move(call));
+    for (std::size_t i = 0; i < lanes; ++i)
+        runInFlight(calls);
+
+    return calls;
+}
+
+/// @brief The coroutine that makes the calls for every index of [0, size) and drops their results. No new calls are
+/// started after the first exception, which is stored.
+template <typename Call>
+core::async<void> forEachInFlight(
+    std::size_t size, Call call, std::size_t maxInFlight, std::shared_ptr<std::exception_ptr> exception)
+{
+    if (0 == size)
+        co_return;
+
+    auto calls = startInFlight<void>(size, std::move(call), maxInFlight);
+    co_await calls->join();
+    *exception = calls->exception();
+}
+
+/// @brief The coroutine that makes the calls for every index of [0, size) and collects their results. No new calls
+/// are started after the first exception, which is stored, the results are empty then.
+template <typename Result, typename Call>
+core::async<std::vector<Result>> transformInFlight(
+    std::size_t size, Call call, std::size_t maxInFlight, std::shared_ptr<std::exception_ptr> exception)
+{
+    if (0 == size)
+        co_return std::vector<Result>{};
+
+    auto calls = startInFlight<Result>(size, std::move(call), maxInFlight);
+    co_await calls->join();
+    *exception = calls->exception();
+    if (*exception)
+        co_return std::vector<Result>{};
+
+    co_return calls->results();
+}
+
+/// @brief The coroutine that starts the async call for every element of the range, keeping at most maxInFlight of
+/// them running at once. The next call starts as soon as any running one is complete.
+/// @param range The parameter that represents the random access range. It should outlive the returned task.
+/// @param func The parameter that represents the function which returns the async task of any flavour.
+/// @param maxInFlight The parameter that represents the maximal count of the running calls. Should be greater then 0.
+/// @return Returns the task which suspends the awaiting coroutine until all the calls are complete, the first
+/// exception of the calls is rethrown to the awaiting coroutine.
+template <std::ranges::random_access_range R, typename F>
+    requires std::ranges::sized_range<R>
+core::throwing_async<void> for_each_async(R &&range, F func, std::size_t maxInFlight)
+{
+    auto call = [first = std::ranges::begin(range), func = std::move(func)](std::size_t index) {
+        return func(first[index]);
+    };
+    auto exception = std::make_shared<std::exception_ptr>();
+    return {forEachInFlight(std::ranges::size(range), std::move(call), maxInFlight, exception), exception};
+}
+
+/// @brief The coroutine that collects the results of the async call for every element of the range, keeping at most
+/// maxInFlight of them running at once. The results, e.g. std::expected of the expected flavour, keep the order of the
+/// elements regardless of the order the calls are complete in.
+/// @param range The parameter that represents the random access range. It should outlive the returned task.
+/// @param func The parameter that represents the function which returns the async task of any flavour.
+/// @param maxInFlight The parameter that represents the maximal count of the running calls. Should be greater then 0.
+/// @return Returns the task which results in the vector of the call results, the first exception of the calls is
+/// rethrown to the awaiting coroutine instead.
+template <std::ranges::random_access_range R, typename F,
+    typename Result = std::remove_cvref_t<await_result_t<std::invoke_result_t<F &, std::ranges::range_reference_t<R>>>>>
+    requires std::ranges::sized_range<R>
+core::throwing_async<std::vector<Result>> transform_async(R &&range, F func, std::size_t maxInFlight)
+{
+    auto call = [first = std::ranges::begin(range), func = std::move(func)](std::size_t index) {
+        return func(first[index]);
+    };
+    auto exception = std::make_shared<std::exception_ptr>();
+    return {transformInFlight<Result>(std::ranges::size(range), std::move(call), maxInFlight, exception), exception};
+}
+} // namespace coasyncpp
+
+#endif
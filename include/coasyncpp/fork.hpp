@@ -0,0 +1,84 @@
+#ifndef __COASYNCPP_FORK_HPP__
+#define __COASYNCPP_FORK_HPP__
+
+#include "common.hpp"
+#include "scheduler.hpp"
+
+#include <atomic>
+#include <coroutine>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The class that represents an awaiter which spawns the child task and continues the parent inline.
+/// @tparam Task The type of the child task, async<T> of any flavour.
+template <typename Task> class fork_awaiter
+{
+  public:
+    fork_awaiter(Task &child) : child_{child}
+    {
+    }
+    bool await_ready() noexcept
+    {
+        return false;
+    }
+    template <typename P> bool await_suspend(std::coroutine_handle<P> parentHandle)
+    {
+        auto &forks = parentHandle.promise().forks_;
+        forks.pending_.fetch_add(1, std::memory_order_relaxed);
+        Scheduler::getInstance()->spawn(child_.fork(&forks));
+
+        // The parent isn't suspended.
+        return false;
+    }
+    void await_resume() noexcept
+    {
+    }
+
+  private:
+    Task &child_;
+};
+
+/// @brief The class that represents an awaiter which suspends the parent until all its forked children are complete.
+class join_awaiter
+{
+  public:
+    bool await_ready() noexcept
+    {
+        return false;
+    }
+    template <typename P> bool await_suspend(std::coroutine_handle<P> parentHandle) noexcept
+    {
+        forks_ = &parentHandle.promise().forks_;
+        forks_->joiner_ = parentHandle;
+
+        // Releases the count of the parent itself, the last child to complete resumes the parent.
+        return forks_->pending_.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+    void await_resume() noexcept
+    {
+        // Ready for the next fork.
+        forks_->pending_.store(1, std::memory_order_relaxed);
+    }
+
+  private:
+    fork_state *forks_{};
+};
+
+/// @brief Starts the child task on the local deque of the Scheduler worker, where the idle workers may steal it from,
+/// the parent continues inline. The child should outlive the join, its result is available after the join.
+/// @param child The parameter that represents the child task, async<T> of any flavour.
+template <typename Task> fork_awaiter<Task> fork(Task &child)
+{
+    return {child};
+}
+
+/// @brief Suspends the parent until all the children it forked are complete. Should be awaited before the parent is
+/// over.
+inline join_awaiter join()
+{
+    return {};
+}
+} // namespace coasyncpp
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef __COASYNCPP_FRAMES_HPP__
+#define __COASYNCPP_FRAMES_HPP__
+
+// The frames of the coroutines are accounted only when COASYNCPP_FRAME_STATS is defined, otherwise the allocation is
+// the default one.
+#ifdef COASYNCPP_FRAME_STATS
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <source_location>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The namespace that represents the accounting of the coroutine frames.
+namespace frames
+{
+/// @brief Raises the high-water mark to the value.
+inline void raise(std::atomic<std::size_t> &highWater, std::size_t value)
+{
+    auto current = highWater.load(std::memory_order_relaxed);
+    while (current < value && !highWater.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        ;
+}
+
+/// @brief The class that represents the frames of the single coroutine function.
+class site
+{
+  public:
+    site(std::source_location location) :
+        function_{location.function_name()}, file_{location.file_name()}, line_{location.line()}
+    {
+    }
+
+    void allocate(std::size_t size)
+    {
+        frameSize_.store(size, std::memory_order_relaxed);
+        total_.fetch_add(1, std::memory_order_relaxed);
+        raise(highWater_, live_.fetch_add(1, std::memory_order_relaxed) + 1);
+        liveBytes_.fetch_add(size, std::memory_order_relaxed);
+    }
+    void deallocate(std::size_t size)
+    {
+        live_.fetch_sub(1, std::memory_order_relaxed);
+        liveBytes_.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    std::string const function_;
+    std::string const file_;
+    std::uint_least32_t const line_;
+    // The frames of the same function are of the same size.
+    std::atomic<std::size_t> frameSize_{};
+    std::atomic<std::size_t> live_{};
+    std::atomic<std::size_t> liveBytes_{};
+    // The maximal count of the live frames.
+    std::atomic<std::size_t> highWater_{};
+    std::atomic<std::size_t> total_{};
+};
+
+/// @brief The struct that represents the snapshot of the frames of the coroutine function.
+struct site_stats
+{
+    std::string function_{};
+    std::string file_{};
+    std::uint_least32_t line_{};
+    std::size_t frameSize_{};
+    std::size_t live_{};
+    std::size_t liveBytes_{};
+    std::size_t highWater_{};
+    std::size_t total_{};
+};
+
+/// @brief The struct that represents the snapshot of the frames of all the coroutine functions, the largest live bytes
+/// first.
+struct frame_stats
+{
+    std::vector<site_stats> sites_{};
+    std::size_t liveFrames_{};
+    std::size_t liveBytes_{};
+    std::size_t highWaterBytes_{};
+};
+
+/// @brief The class that represents the registry of the coroutine functions by their source location, the sites are
+/// never removed.
+class registry
+{
+  public:
+    static registry &getInstance()
+    {
+        // Never destroyed, the frames may be freed during the exit.
+        static registry *instance = new registry{};
+        return *instance;
+    }
+
+    /// @brief Returns the site of the location, the registry is locked only on the first call of the thread.
+    site *get(std::source_location location)
+    {
+        // The function name of the same location is the same string.
+        thread_local std::unordered_map<char const *, site *> cached{};
+        auto &found = cached[location.function_name()];
+        if (nullptr == found)
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            auto key = std::string{location.file_name()} + ":" + std::to_string(location.line()) + ":" +
+                       location.function_name();
+            auto &registered = sites_[key];
+            if (!registered)
+                registered = std::make_unique<site>(location);
+            found = registered.get();
+        }
+
+        return found;
+    }
+
+    void allocate(site *allocated, std::size_t size)
+    {
+        allocated->allocate(size);
+        liveFrames_.fetch_add(1, std::memory_order_relaxed);
+        raise(highWaterBytes_, liveBytes_.fetch_add(size, std::memory_order_relaxed) + size);
+    }
+    void deallocate(site *allocated, std::size_t size)
+    {
+        allocated->deallocate(size);
+        liveFrames_.fetch_sub(1, std::memory_order_relaxed);
+        liveBytes_.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    frame_stats take()
+    {
+        frame_stats taken{};
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            for (auto const &[key, registered] : sites_)
+            {
+                taken.sites_.push_back({registered->function_, registered->file_, registered->line_,
+                    registered->frameSize_.load(std::memory_order_relaxed),
+                    registered->live_.load(std::memory_order_relaxed),
+                    registered->liveBytes_.load(std::memory_order_relaxed),
+                    registered->highWater_.load(std::memory_order_relaxed),
+                    registered->total_.load(std::memory_order_relaxed)});
+            }
+        }
+        std::sort(taken.sites_.begin(), taken.sites_.end(),
+            [](auto const &lh, auto const &rh) { return lh.liveBytes_ > rh.liveBytes_; });
+
+        taken.liveFrames_ = liveFrames_.load(std::memory_order_relaxed);
+        taken.liveBytes_ = liveBytes_.load(std::memory_order_relaxed);
+        taken.highWaterBytes_ = highWaterBytes_.load(std::memory_order_relaxed);
+
+        return taken;
+    }
+
+  private:
+    registry() = default;
+
+    std::mutex mutex_{};
+    std::unordered_map<std::string, std::unique_ptr<site>> sites_{};
+    std::atomic<std::size_t> liveFrames_{};
+    std::atomic<std::size_t> liveBytes_{};
+    std::atomic<std::size_t> highWaterBytes_{};
+};
+
+/// @brief Returns the snapshot of the frames of all the coroutine functions.
+inline frame_stats snapshot()
+{
+    return registry::getInstance().take();
+}
+
+/// @brief Writes the frames in the Prometheus text format.
+inline void dump(std::ostream &out)
+{
+    auto taken = snapshot();
+
+    out << "coasyncpp_frames_live " << taken.liveFrames_ << "\n";
+    out << "coasyncpp_frames_live_bytes " << taken.liveBytes_ << "\n";
+    out << "coasyncpp_frames_high_water_bytes " << taken.highWaterBytes_ << "\n";
+    for (auto const &site : taken.sites_)
+    {
+        auto label = "{function=\"" + site.function_ + "\",location=\"" + site.file_ + ":" +
+                     std::to_string(site.line_) + "\"}";
+        out << "coasyncpp_frame_size_bytes" << label << " " << site.frameSize_ << "\n";
+        out << "coasyncpp_frame_live" << label << " " << site.live_ << "\n";
+        out << "coasyncpp_frame_live_bytes" << label << " " << site.liveBytes_ << "\n";
+        out << "coasyncpp_frame_high_water" << label << " " << site.highWater_ << "\n";
+        out << "coasyncpp_frame_allocated_total" << label << " " << site.total_ << "\n";
+    }
+}
+
+/// @brief Dumps the frames to the standard error when the program exits, e.g. to find the frames which are leaked.
+inline void dumpAtExit()
+{
+    std::atexit([]() { dump(std::cerr); });
+}
+} // namespace frames
+
+/// @brief The class that represents the allocator of the coroutine frame, the base of the promise. The frame is
+/// prefixed with the site of the coroutine function it's allocated for.
+class frame_allocator
+{
+  public:
+    // The coroutine parameters never match the location, so the compiler falls back to the size only overload, where
+    // the default location is the one of the coroutine function.
+    static void *operator new(std::size_t size, std::source_location location = std::source_location::current())
+    {
+        auto allocated = frames::registry::getInstance().get(location);
+        auto memory = static_cast<std::byte *>(::operator new(headerSize + size));
+        *reinterpret_cast<frames::site **>(memory) = allocated;
+        frames::registry::getInstance().allocate(allocated, size);
+
+        return memory + headerSize;
+    }
+    static void operator delete(void *pointer, std::size_t size)
+    {
+        auto memory = static_cast<std::byte *>(pointer) - headerSize;
+        frames::registry::getInstance().deallocate(*reinterpret_cast<frames::site **>(memory), size);
+        ::operator delete(memory);
+    }
+
+  private:
+    // Keeps the frame aligned as the default allocation does.
+    static constexpr std::size_t headerSize{__STDCPP_DEFAULT_NEW_ALIGNMENT__};
+};
+} // namespace coasyncpp
+
+#else
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The class that represents the allocator of the coroutine frame, the default one since the accounting is off.
+class frame_allocator
+{
+};
+} // namespace coasyncpp
+
+#endif
+
+#endif
@@ -0,0 +1,245 @@
+#ifndef __COASYNCPP_GENERATOR_HPP__
+#define __COASYNCPP_GENERATOR_HPP__
+
+#include "common.hpp"
+
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The class that represents a range whose elements should be yielded one by one. When the range is a
+/// generator, its frame is pushed on the generator stack and resumed directly, without re-yielding via the parent.
+/// @tparam R The type of the range.
+template <typename R> struct elements_of
+{
+    R range_;
+};
+template <typename R> elements_of(R &&) -> elements_of<R &&>;
+
+/// @brief The class that represents synchronous generator modelled on the std::generator. Values are yielded by
+/// reference directly from the coroutine frame, so nothing is copied unless an lvalue is yielded from generator<T>.
+/// @tparam T The type of the generated values. generator<T> yields T&&, generator<T const &> yields T const &.
+template <typename T> class generator : public std::ranges::view_interface<generator<T>>
+{
+  public:
+    using value_type = std::remove_cvref_t<T>;
+    using reference = std::conditional_t<std::is_reference_v<T>, T, T &&>;
+    using yielded = std::conditional_t<std::is_reference_v<reference>, reference, reference const &>;
+
+    // Promise type of the Self Result
+    struct promise_type : frame_allocator
+    {
+        /// @brief The class that represents an awaiter which keeps a copy of the yielded lvalue in the frame.
+        class copy_awaiter
+        {
+          public:
+            copy_awaiter(std::remove_reference_t<yielded> const &value, promise_type &promise) :
+                value_{value}, promise_{promise}
+            {
+            }
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+            void await_suspend(std::coroutine_handle<>) noexcept
+            {
+                promise_.root_->value_ = std::addressof(value_);
+            }
+            void await_resume() noexcept
+            {
+            }
+
+          private:
+            std::remove_cvref_t<yielded> value_;
+            promise_type &promise_;
+        };
+
+        /// @brief The class that represents an awaiter which pushes the nested generator on the generator stack.
+        class nested_awaiter
+        {
+          public:
+            nested_awaiter(generator nested) : nested_{std::move(nested)}
+            {
+            }
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> parentHandle) noexcept
+            {
+                auto &nested = nested_.selfHandle_.promise();
+                auto &root = *parentHandle.promise().root_;
+
+                nested.root_ = &root;
+                nested.callerHandle_ = parentHandle;
+                nested.isFromStackCall_ = false;
+                root.leaf_ = nested_.selfHandle_;
+
+                return nested_.selfHandle_;
+            }
+            void await_resume()
+            {
+                if (auto &exception = nested_.selfHandle_.promise().exception_)
+                    std::rethrow_exception(std::exchange(exception, nullptr));
+            }
+
+          private:
+            generator nested_;
+        };
+
+        std::suspend_always initial_suspend()
+        {
+            return {};
+        }
+        resume_awaiter<promise_type> final_suspend() noexcept
+        {
+            isDone_ = true;
+            // Pop the nested generator from the generator stack, resume_awaiter transfers to the parent.
+            if (root_ != this)
+                root_->leaf_ = callerHandle_;
+            return {isFromStackCall_};
+        }
+        std::suspend_always yield_value(yielded value) noexcept
+        {
+            root_->value_ = std::addressof(value);
+            return {};
+        }
+        copy_awaiter yield_value(std::remove_reference_t<yielded> const &value)
+            requires std::is_rvalue_reference_v<yielded> &&
+                     std::constructible_from<std::remove_cvref_t<yielded>, std::remove_reference_t<yielded> const &>
+        {
+            return {value, *this};
+        }
+        nested_awaiter yield_value(elements_of<generator &&> elements) noexcept
+        {
+            return {std::move(elements.range_)};
+        }
+        template <std::ranges::input_range R> nested_awaiter yield_value(elements_of<R> elements)
+        {
+            return {[](R range) -> generator {
+                for (auto &&value : range)
+                    co_yield std::forward<decltype(value)>(value);
+            }(std::forward<R>(elements.range_))};
+        }
+        void return_void()
+        {
+        }
+        void unhandled_exception()
+        {
+            exception_ = std::current_exception();
+        }
+        auto get_return_object()
+        {
+            return generator<T>(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        template <typename U> std::suspend_never await_transform(U &&) = delete;
+
+        std::add_pointer_t<yielded> value_{};
+        std::exception_ptr exception_{};
+        promise_type *root_{this};
+        std::coroutine_handle<> leaf_{std::coroutine_handle<promise_type>::from_promise(*this)};
+        std::coroutine_handle<> callerHandle_{};
+        bool isFromStackCall_{true};
+        bool isDone_{};
+    };
+
+    /// @brief The class that represents move-only input iterator over the generator.
+    class iterator
+    {
+      public:
+        using value_type = generator::value_type;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        iterator(iterator &&other) noexcept : selfHandle_{std::exchange(other.selfHandle_, {})}
+        {
+        }
+        iterator &operator=(iterator &&other) noexcept
+        {
+            selfHandle_ = std::exchange(other.selfHandle_, {});
+            return *this;
+        }
+
+        reference operator*() const
+        {
+            return static_cast<reference>(*selfHandle_.promise().value_);
+        }
+        iterator &operator++()
+        {
+            resume(selfHandle_);
+            return *this;
+        }
+        void operator++(int)
+        {
+            ++*this;
+        }
+
+        friend bool operator==(iterator const &i, std::default_sentinel_t)
+        {
+            return i.selfHandle_.promise().isDone_;
+        }
+
+      private:
+        friend class generator;
+
+        iterator(std::coroutine_handle<promise_type> selfHandle) : selfHandle_{selfHandle}
+        {
+        }
+
+        std::coroutine_handle<promise_type> selfHandle_{};
+    };
+
+    // Members
+    generator(generator &&other) noexcept : selfHandle_{std::exchange(other.selfHandle_, {})}
+    {
+    }
+    generator &operator=(generator other) noexcept
+    {
+        std::swap(selfHandle_, other.selfHandle_);
+        return *this;
+    }
+    ~generator()
+    {
+        if (selfHandle_)
+            selfHandle_.destroy();
+    }
+
+    iterator begin()
+    {
+        resume(selfHandle_);
+        return iterator{selfHandle_};
+    }
+    std::default_sentinel_t end() const noexcept
+    {
+        return {};
+    }
+
+  protected:
+  private:
+    generator(std::coroutine_handle<promise_type> selfHandle) : selfHandle_{selfHandle}
+    {
+    }
+
+    static void resume(std::coroutine_handle<promise_type> selfHandle)
+    {
+        // Resume the innermost generator directly, so the resume cost doesn't depend on the nesting depth.
+        selfHandle.promise().leaf_.resume();
+
+        if (auto &exception = selfHandle.promise().exception_)
+            std::rethrow_exception(std::exchange(exception, nullptr));
+    }
+
+    std::coroutine_handle<promise_type> selfHandle_{};
+};
+} // namespace coasyncpp
+
+#endif
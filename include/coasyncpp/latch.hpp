@@ -0,0 +1,65 @@
+#ifndef __COASYNCPP_LATCH_HPP__
+#define __COASYNCPP_LATCH_HPP__
+
+#include "common.hpp"
+#include "scheduler.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The class that represents single use countdown. The coroutine awaiting it is suspended until the count
+/// reaches zero and is resumed on the Scheduler by the last count down.
+class async_latch
+{
+  public:
+    /// @brief The class that represents an awaiter which suspends until the count reaches zero.
+    class awaiter
+    {
+      public:
+        awaiter(async_latch &latch) : latch_{latch}
+        {
+        }
+        bool await_ready() noexcept
+        {
+            return false;
+        }
+        bool await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            latch_.continuation_ = handle;
+            // The awaiter holds one of the counts, so the last count down sees the continuation.
+            return latch_.pending_.fetch_sub(1, std::memory_order_acq_rel) != 1;
+        }
+        void await_resume() noexcept
+        {
+        }
+
+      private:
+        async_latch &latch_;
+    };
+
+    async_latch(std::size_t count) : pending_{count + 1}
+    {
+    }
+
+    void countDown()
+    {
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Scheduler::getInstance()->spawn(continuation_);
+    }
+    /// @brief Waits until the count reaches zero. Should be awaited only once.
+    awaiter wait()
+    {
+        return {*this};
+    }
+
+  private:
+    std::atomic<std::size_t> pending_{};
+    std::coroutine_handle<> continuation_{};
+};
+} // namespace coasyncpp
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef __COASYNCPP_PARALLEL_HPP__
+#define __COASYNCPP_PARALLEL_HPP__
+
+#include "common.hpp"
+#include "scheduler.hpp"
+#include "async_core.hpp"
+#include "latch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <utility>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The constant that represents the time the single chunk of the parallel algorithm should take. Long enough
+/// to amortize the chunk scheduling, short enough to balance the load between the workers.
+inline constexpr std::chrono::microseconds parallelChunkDuration{100};
+/// @brief The constant that represents the count of the elements in the first chunk, which measures the element cost.
+inline constexpr std::size_t parallelFirstChunkSize{16};
+
+/// @brief The class that represents the state of the parallel algorithm shared by all its runners. The runners take
+/// the chunks of the indices until the range is over and resume the awaiting coroutine when the last one is done.
+/// @tparam Body The type of the function which processes the element with the given index.
+template <typename Body> class parallel_chunks
+{
+  public:
+    parallel_chunks(std::size_t size, std::size_t firstChunk, std::size_t runners, Body body) :
+        body_{std::move(body)}, size_{size}, firstChunk_{firstChunk}, runners_{runners}, latch_{runners}
+    {
+    }
+
+    /// @brief Processes the chunks until the range is over. The chunk size follows the measured cost per element.
+    void run()
+    {
+        auto chunk = std::min(firstChunk_, size_);
+        while (true)
+        {
+            auto first = next_.fetch_add(chunk, std::memory_order_relaxed);
+            if (first >= size_)
+                break;
+
+            auto last = std::min(first + chunk, size_);
+            auto start = std::chrono::steady_clock::now();
+            try
+            {
+                for (auto index = first; index < last; ++index)
+                    body_(index);
+            }
+            catch (...)
+            {
+                fail(std::current_exception());
+                break;
+            }
+            auto elapsed = std::chrono::steady_clock::now() - start;
+
+            chunk = nextChunk(elapsed / (last - first));
+        }
+    }
+    /// @brief Marks the runner done. The last one resumes the awaiting coroutine on the Scheduler.
+    void done()
+    {
+        latch_.countDown();
+    }
+    /// @brief Waits until all the runners are done.
+    async_latch::awaiter join()
+    {
+        return latch_.wait();
+    }
+    /// @brief Returns the first exception of the body, null if none.
+    std::exception_ptr exception() const
+    {
+        return exception_;
+    }
+
+  private:
+    std::size_t nextChunk(std::chrono::steady_clock::duration perElement) const
+    {
+        auto target = static_cast<std::size_t>(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(parallelChunkDuration) /
+            std::max(perElement, std::chrono::steady_clock::duration{1}));
+
+        // Smaller chunks towards the end of the range, so all the runners finish about the same time.
+        auto next = next_.load(std::memory_order_relaxed);
+        auto remaining = next < size_ ? size_ - next : 0;
+        auto guided = remaining / (2 * runners_);
+
+        return std::max<std::size_t>(1, std::min(target, guided));
+    }
+    void fail(std::exception_ptr exception)
+    {
+        if (!failed_.test_and_set())
+            exception_ = exception;
+
+        // Lets the other runners stop at the next chunk.
+        next_.store(size_, std::memory_order_relaxed);
+    }
+
+    Body body_;
+    std::size_t size_{};
+    std::size_t firstChunk_{};
+    std::size_t runners_{};
+    std::atomic<std::size_t> next_{};
+    async_latch latch_;
+    std::atomic_flag failed_{};
+    std::exception_ptr exception_{};
+};
+
+/// @brief The coroutine that runs the chunks of the parallel algorithm on the Scheduler worker.
+template <typename Body> detached_task runChunks(std::shared_ptr<parallel_chunks<Body>> chunks)
+{
+    chunks->run();
+    chunks->done();
+    co_return;
+}
+
+/// @brief The coroutine that processes every index of [0, size) in parallel by the Scheduler workers and the awaiting
+/// coroutine itself. The body stops at the first exception, which is stored.
+/// @param size The parameter that represents the count of the indices.
+/// @param body The parameter that represents the function to call for every index. It's called concurrently.
+/// @param firstChunk The parameter that represents the count of the indices to measure the cost per index with.
+/// @param exception The parameter that represents the first exception of the body, set once the task is complete.
+template <typename Body>
+core::async<void> runIndices(
+    std::size_t size, Body body, std::size_t firstChunk, std::shared_ptr<std::exception_ptr> exception)
+{
+    if (0 == size)
+        co_return;
+
+    // The awaiting coroutine is one of the runners, so the rest is one per worker.
+    auto runners = std::min(Scheduler::getInstance()->workerCount(), (size + firstChunk - 1) / firstChunk);
+    auto chunks = std::make_shared<parallel_chunks<Body>>(size, firstChunk, runners + 1, std::move(body));
+
+    for (std::size_t i = 0; i < runners; ++i)
+        runChunks(chunks);
+
+    chunks->run();
+    chunks->done();
+    co_await chunks->join();
+    *exception = chunks->exception();
+}
+
+/// @brief Processes every index of [0, size) in parallel, see runIndices(). The first exception of the body is rethrown
+/// to the awaiting coroutine.
+template <typename Body>
+core::throwing_async<void> parallelIndices(std::size_t size, Body body, std::size_t firstChunk = parallelFirstChunkSize)
+{
+    auto exception = std::make_shared<std::exception_ptr>();
+    return {runIndices(size, std::move(body), firstChunk, exception), exception};
+}
+
+/// @brief The coroutine that calls the function for every element of the range in parallel. The range is split into
+/// chunks which sizes adapt to the measured cost per element, so both cheap and heavy elements are balanced.
+/// @param range The parameter that represents the random access range. It should outlive the returned task.
+/// @param func The parameter that represents the function to call for every element. It's called concurrently.
+/// @return Returns the task which suspends the awaiting coroutine until all the elements are processed, the first
+/// exception of the function is rethrown to the awaiting coroutine.
+template <std::ranges::random_access_range R, typename F>
+    requires std::ranges::sized_range<R>
+core::throwing_async<void> parallel_for_each(R &&range, F func)
+{
+    return parallelIndices(std::ranges::size(range),
+        [first = std::ranges::begin(range), func = std::move(func)](std::size_t index) mutable { func(first[index]); });
+}
+
+/// @brief The coroutine that writes the function results for every element of the range in parallel.
+/// @param range The parameter that represents the random access range. It should outlive the returned task.
+/// @param out The parameter that represents the beginning of the random access output of the same size.
+/// @param func The parameter that represents the function to transform every element with. It's called concurrently.
+/// @return Returns the task which suspends the awaiting coroutine until all the elements are transformed, the first
+/// exception of the function is rethrown to the awaiting coroutine.
+template <std::ranges::random_access_range R, std::random_access_iterator O, typename F>
+    requires std::ranges::sized_range<R>
+core::throwing_async<void> parallel_transform(R &&range, O out, F func)
+{
+    return parallelIndices(std::ranges::size(range),
+        [first = std::ranges::begin(range), out, func = std::move(func)](std::size_t index) mutable {
+            out[index] = func(first[index]);
+        });
+}
+} // namespace coasyncpp
+
+#endif
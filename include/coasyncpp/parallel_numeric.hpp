@@ -0,0 +1,350 @@
+#ifndef __COASYNCPP_PARALLEL_NUMERIC_HPP__
+#define __COASYNCPP_PARALLEL_NUMERIC_HPP__
+
+#include "common.hpp"
+#include "scheduler.hpp"
+#include "async_core.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// The SIMD kernels are used when <experimental/simd> is available, unless COASYNCPP_NO_SIMD is defined.
+#if __has_include(<experimental/simd>) && !defined(COASYNCPP_NO_SIMD)
+#include <experimental/simd>
+#define COASYNCPP_HAS_SIMD 1
+#endif
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The constant that represents the minimal count of the elements per block of the numeric algorithms.
+inline constexpr std::size_t parallelMinBlockSize{16 * 1024};
+/// @brief The constant that represents the count of the blocks per worker, so the faster workers take more blocks.
+inline constexpr std::size_t parallelBlocksPerWorker{8};
+
+/// @brief The type trait that represents the identity element of the operation, if it is known.
+template <typename Op, typename T> struct operation_identity
+{
+};
+template <typename T> struct operation_identity<std::plus<>, T>
+{
+    static constexpr T value{0};
+};
+template <typename T> struct operation_identity<std::plus<T>, T>
+{
+    static constexpr T value{0};
+};
+template <typename T> struct operation_identity<std::multiplies<>, T>
+{
+    static constexpr T value{1};
+};
+template <typename T> struct operation_identity<std::multiplies<T>, T>
+{
+    static constexpr T value{1};
+};
+
+#ifdef COASYNCPP_HAS_SIMD
+namespace stdx = std::experimental;
+
+/// @brief The type that represents the widest SIMD register of the target for the value type.
+template <typename T> using simd_type = stdx::native_simd<T>;
+
+/// @brief The concept that represents the operation which may be applied to the whole SIMD registers.
+template <typename Op, typename T>
+concept simd_operation = std::is_arithmetic_v<T> && !std::same_as<T, bool> && requires(Op op, simd_type<T> v) {
+    {
+        op(v, v)
+    } -> std::convertible_to<simd_type<T>>;
+};
+/// @brief The concept that represents the operation which prefix sums may be computed within the SIMD register.
+template <typename Op, typename T>
+concept simd_scan_operation = simd_operation<Op, T> && requires { operation_identity<Op, T>::value; };
+
+/// @brief Computes the prefix of the SIMD register in log2(width) steps, by shifting the lanes in the identity.
+template <std::size_t Shift, typename T, typename Op> simd_type<T> simdPrefix(simd_type<T> v, Op op)
+{
+    if constexpr (Shift >= simd_type<T>::size())
+        return v;
+    else
+    {
+        simd_type<T> shifted([&v](auto lane) -> T {
+            if constexpr (decltype(lane)::value >= Shift)
+                return v[decltype(lane)::value - Shift];
+            else
+                return operation_identity<Op, T>::value;
+        });
+
+        return simdPrefix<2 * Shift, T>(op(v, shifted), op);
+    }
+}
+#endif
+
+/// @brief Reduces the non empty block. The SIMD kernel keeps several accumulators to hide the latency of the
+/// operation, so the order of the elements isn't kept, like in std::reduce.
+template <typename T, typename Op> T reduceBlock(T const *first, std::size_t size, Op op)
+{
+    std::size_t i{};
+    T result{};
+
+#ifdef COASYNCPP_HAS_SIMD
+    if constexpr (simd_operation<Op, T>)
+    {
+        using simd = simd_type<T>;
+        constexpr std::size_t width = simd::size();
+
+        if (size >= 4 * width)
+        {
+            simd acc0{first, stdx::element_aligned};
+            simd acc1{first + width, stdx::element_aligned};
+            simd acc2{first + 2 * width, stdx::element_aligned};
+            simd acc3{first + 3 * width, stdx::element_aligned};
+            for (i = 4 * width; i + 4 * width <= size; i += 4 * width)
+            {
+                acc0 = op(acc0, simd{first + i, stdx::element_aligned});
+                acc1 = op(acc1, simd{first + i + width, stdx::element_aligned});
+                acc2 = op(acc2, simd{first + i + 2 * width, stdx::element_aligned});
+                acc3 = op(acc3, simd{first + i + 3 * width, stdx::element_aligned});
+            }
+            for (; i + width <= size; i += width)
+                acc0 = op(acc0, simd{first + i, stdx::element_aligned});
+
+            result = stdx::reduce(simd{op(op(acc0, acc1), op(acc2, acc3))}, op);
+        }
+    }
+#endif
+
+    if (0 == i)
+        result = first[i++];
+    for (; i < size; ++i)
+        result = op(result, first[i]);
+
+    return result;
+}
+
+/// @brief Writes the inclusive prefixes of the block, combined with the carry of the previous blocks if any.
+template <typename T, typename Op> void scanBlock(T const *first, T *out, std::size_t size, Op op, T const *carry)
+{
+    std::size_t i{};
+
+#ifdef COASYNCPP_HAS_SIMD
+    if constexpr (simd_scan_operation<Op, T>)
+    {
+        using simd = simd_type<T>;
+        constexpr std::size_t width = simd::size();
+
+        simd carries{carry ? *carry : operation_identity<Op, T>::value};
+        for (; i + width <= size; i += width)
+        {
+            auto prefix = op(simdPrefix<1, T>(simd{first + i, stdx::element_aligned}, op), carries);
+            prefix.copy_to(out + i, stdx::element_aligned);
+            carries = prefix[width - 1];
+        }
+
+        if (i > 0)
+            carry = out + i - 1;
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+        out[i] = carry ? op(*carry, first[i]) : first[i];
+        carry = out + i;
+    }
+}
+
+/// @brief The class that represents the binary tree combining the block results. The second child to arrive combines
+/// the pair and climbs up, so the combine runs on the workers without any barrier between the levels.
+/// @tparam T The type of the values.
+/// @tparam Op The type of the associative operation.
+template <typename T, typename Op> class reduce_tree
+{
+  public:
+    reduce_tree(std::size_t blocks, Op op) :
+        leaves_{std::bit_ceil(blocks)}, blocks_{blocks}, values_(2 * leaves_), pending_(leaves_), op_{std::move(op)}
+    {
+        for (std::size_t node = 1; node < leaves_; ++node)
+            pending_[node] = isPresent(2 * node + 1) ? 2 : 1;
+    }
+
+    /// @brief Sets the result of the block and combines the nodes above it, if their other children are ready.
+    void set(std::size_t block, T value)
+    {
+        auto node = leaves_ + block;
+        values_[node] = std::move(value);
+
+        for (; node > 1; node /= 2)
+        {
+            auto parent = node / 2;
+            if (pending_[parent].fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+
+            values_[parent] =
+                isPresent(2 * parent + 1) ? op_(values_[2 * parent], values_[2 * parent + 1]) : values_[2 * parent];
+        }
+    }
+    T const &root() const
+    {
+        return values_[1];
+    }
+
+  private:
+    /// @brief Checks the node covers at least one block, the tree is padded to the power of 2 leaves.
+    bool isPresent(std::size_t node) const
+    {
+        while (node < leaves_)
+            node *= 2;
+
+        return node - leaves_ < blocks_;
+    }
+
+    std::size_t leaves_{};
+    std::size_t blocks_{};
+    std::vector<T> values_{};
+    std::vector<std::atomic<unsigned char>> pending_;
+    Op op_;
+};
+
+/// @brief Returns the count of the elements per block, at least one block per worker and SIMD friendly.
+inline std::size_t parallelBlockSize(std::size_t size)
+{
+    auto blocks = Scheduler::getInstance()->workerCount() * parallelBlocksPerWorker;
+    auto blockSize = std::max(parallelMinBlockSize, (size + blocks - 1) / blocks);
+
+    // Rounded to the cache line, so the blocks don't share the cache lines.
+    return (blockSize + 63) / 64 * 64;
+}
+
+/// @brief The coroutine that represents the parallel reduce of the span. The first exception of the operation is
+/// stored, the result is not reduced then.
+template <typename V, typename T, typename Op>
+core::async<T> parallelReduce(std::span<V const> values, T init, Op op, std::shared_ptr<std::exception_ptr> exception)
+{
+    if (values.empty())
+        co_return init;
+
+    auto blockSize = parallelBlockSize(values.size());
+    auto blocks = (values.size() + blockSize - 1) / blockSize;
+
+    reduce_tree<V, Op> tree{blocks, op};
+    co_await runIndices(
+        blocks,
+        [values, blockSize, &tree, &op](std::size_t block) {
+            auto chunk = values.subspan(block * blockSize, std::min(blockSize, values.size() - block * blockSize));
+            tree.set(block, reduceBlock(chunk.data(), chunk.size(), op));
+        },
+        1, exception);
+    if (*exception)
+        co_return init;
+
+    try
+    {
+        init = op(init, tree.root());
+    }
+    catch (...)
+    {
+        *exception = std::current_exception();
+    }
+    co_return init;
+}
+
+/// @brief The coroutine that represents the parallel inclusive scan of the span. The block sums are reduced first,
+/// then every block is scanned with the sum of the previous blocks as the carry. The first exception of the operation
+/// is stored, the scan stops then.
+template <typename T, typename Op>
+core::async<void> parallelInclusiveScan(
+    std::span<T const> values, T *out, Op op, std::shared_ptr<std::exception_ptr> exception)
+{
+    if (values.empty())
+        co_return;
+
+    auto blockSize = parallelBlockSize(values.size());
+    auto blocks = (values.size() + blockSize - 1) / blockSize;
+    auto block = [values, blockSize](std::size_t index) {
+        return values.subspan(index * blockSize, std::min(blockSize, values.size() - index * blockSize));
+    };
+
+    // The last block sum isn't a carry of any block.
+    std::vector<T> carries(blocks);
+    co_await runIndices(
+        blocks - 1,
+        [&block, &carries, &op](std::size_t index) {
+            auto chunk = block(index);
+            carries[index + 1] = reduceBlock(chunk.data(), chunk.size(), op);
+        },
+        1, exception);
+    if (*exception)
+        co_return;
+
+    try
+    {
+        for (std::size_t index = 2; index < blocks; ++index)
+            carries[index] = op(carries[index - 1], carries[index]);
+    }
+    catch (...)
+    {
+        *exception = std::current_exception();
+        co_return;
+    }
+
+    co_await runIndices(
+        blocks,
+        [&block, &carries, out, blockSize, &op](std::size_t index) {
+            auto chunk = block(index);
+            scanBlock(chunk.data(), out + index * blockSize, chunk.size(), op, index > 0 ? &carries[index] : nullptr);
+        },
+        1, exception);
+}
+
+/// @brief The coroutine that reduces the contiguous range in parallel by the Scheduler workers. Every block is reduced
+/// by the SIMD kernel, the block results are combined in the tree.
+/// @param range The parameter that represents the contiguous range. It should outlive the returned task.
+/// @param init The parameter that represents the initial value.
+/// @param op The parameter that represents the associative and commutative operation, like in std::reduce.
+/// @return Returns the task which suspends the awaiting coroutine until the result is ready, the first exception of
+/// the operation is rethrown to the awaiting coroutine.
+template <std::ranges::contiguous_range R, typename T, typename Op = std::plus<>>
+    requires std::ranges::sized_range<R>
+core::throwing_async<T> parallel_reduce(R &&range, T init, Op op = {})
+{
+    using value_type = std::ranges::range_value_t<R>;
+
+    auto exception = std::make_shared<std::exception_ptr>();
+    return {parallelReduce(std::span<value_type const>{std::ranges::data(range), std::ranges::size(range)}, init,
+                std::move(op), exception),
+        exception};
+}
+
+/// @brief The coroutine that writes the inclusive prefixes of the contiguous range in parallel by the Scheduler
+/// workers. Every block is scanned by the SIMD kernel, when the identity of the operation is known.
+/// @param range The parameter that represents the contiguous range. It should outlive the returned task.
+/// @param out The parameter that represents the beginning of the contiguous output of the same size.
+/// @param op The parameter that represents the associative operation.
+/// @return Returns the task which suspends the awaiting coroutine until all the prefixes are written, the first
+/// exception of the operation is rethrown to the awaiting coroutine.
+template <std::ranges::contiguous_range R, std::contiguous_iterator O, typename Op = std::plus<>>
+    requires std::ranges::sized_range<R>
+core::throwing_async<void> parallel_inclusive_scan(R &&range, O out, Op op = {})
+{
+    using value_type = std::ranges::range_value_t<R>;
+
+    auto exception = std::make_shared<std::exception_ptr>();
+    return {parallelInclusiveScan(std::span<value_type const>{std::ranges::data(range), std::ranges::size(range)},
+                std::to_address(out), std::move(op), exception),
+        exception};
+}
+} // namespace coasyncpp
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef __COASYNCPP_PREFETCH_HPP__
+#define __COASYNCPP_PREFETCH_HPP__
+
+#include "common.hpp"
+#include "scheduler.hpp"
+#include "ring_buffer.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The type that represents value type of the async generator of any flavour.
+template <typename Task> using generator_value_t = std::remove_cvref_t<decltype(std::declval<Task &>().result())>;
+
+/// @brief The class that represents the producer side of the prefetch. It is executed by the Scheduler worker and
+/// runs the generator ahead until the buffer is full.
+/// @tparam Task The type of the async generator.
+template <typename Task> class prefetch_task : public async_interface
+{
+  public:
+    using value_type = generator_value_t<Task>;
+
+    prefetch_task(Task task, std::size_t capacity) : task_{std::move(task)}, buffer_{capacity}
+    {
+    }
+
+    void execute() override
+    {
+        if (cancelled_)
+            return;
+
+        // The generator awaiting anything else, e.g. the timer, is resumed by what it awaits, the step is given up
+        // until it yields.
+        while (!task_.done() && task_.atStep())
+        {
+            if (started_)
+            {
+                // Checked before the result() call to not copy the value which doesn't fit.
+                if (buffer_.full())
+                    return;
+
+                buffer_.tryPush(task_.result());
+            }
+            started_ = true;
+            task_.execute();
+        }
+
+        if (task_.done())
+            finished_.store(true, std::memory_order_release);
+    }
+    bool done() override
+    {
+        return finished_.load(std::memory_order_acquire) || cancelled_.load(std::memory_order_acquire);
+    }
+    async_frame *taskFrame() override
+    {
+        // The generator resumed by the Scheduler is queued along with the producer, which is not stepped meanwhile.
+        return &task_.stackFrame();
+    }
+
+    /// @brief Pops the next prefetched value, waits while the producer is behind.
+    /// @return Returns false when the generator is out of values.
+    bool next(value_type &value)
+    {
+        while (!buffer_.tryPop(value))
+        {
+            if (finished_.load(std::memory_order_acquire))
+                return buffer_.tryPop(value);
+
+            std::this_thread::yield();
+        }
+
+        return true;
+    }
+    void cancel()
+    {
+        cancelled_.store(true, std::memory_order_release);
+    }
+
+  private:
+    Task task_;
+    spsc_ring_buffer<value_type> buffer_;
+    bool started_{};
+    std::atomic<bool> finished_{};
+    std::atomic<bool> cancelled_{};
+};
+
+/// @brief The class that represents the consumer side of the prefetch, the input range over the prefetched values.
+/// @tparam Task The type of the async generator.
+template <typename Task> class prefetch_range : public std::ranges::view_interface<prefetch_range<Task>>
+{
+  public:
+    using value_type = generator_value_t<Task>;
+
+    /// @brief The class that represents the input iterator over the prefetched values.
+    class iterator
+    {
+      public:
+        using value_type = prefetch_range::value_type;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        iterator(prefetch_range *range) : range_{range}
+        {
+        }
+
+        value_type const &operator*() const
+        {
+            return range_->value_;
+        }
+        iterator &operator++()
+        {
+            range_->advance();
+            return *this;
+        }
+        void operator++(int)
+        {
+            ++*this;
+        }
+
+        friend bool operator==(iterator const &i, std::default_sentinel_t)
+        {
+            return i.done();
+        }
+
+      private:
+        bool done() const
+        {
+            return range_->done_;
+        }
+
+        prefetch_range *range_{};
+    };
+
+    prefetch_range(Task task, std::size_t capacity) :
+        producer_{std::make_shared<prefetch_task<Task>>(std::move(task), capacity)}
+    {
+        Scheduler::getInstance()->schedule(producer_);
+    }
+    prefetch_range(prefetch_range &&other) noexcept = default;
+    prefetch_range &operator=(prefetch_range &&other) noexcept = default;
+    ~prefetch_range()
+    {
+        // The scheduler drops the producer once it sees it done.
+        if (producer_)
+            producer_->cancel();
+    }
+
+    iterator begin()
+    {
+        advance();
+        return iterator{this};
+    }
+    std::default_sentinel_t end() const noexcept
+    {
+        return {};
+    }
+
+  private:
+    void advance()
+    {
+        done_ = !producer_->next(value_);
+    }
+
+    std::shared_ptr<prefetch_task<Task>> producer_{};
+    value_type value_{};
+    bool done_{};
+};
+
+/// @brief Runs the async generator ahead of the consumer on the Scheduler worker.
+/// @param task The parameter that represents the async generator, e.g. async<T>.
+/// @param count The parameter that represents the maximal count of values to prefetch. Should be greater then 0.
+/// @return Returns the input range over the generated values.
+template <typename Task> prefetch_range<Task> prefetch(Task task, std::size_t count)
+{
+    assert(count > 0);
+
+    return {std::move(task), count};
+}
+} // namespace coasyncpp
+
+#endif
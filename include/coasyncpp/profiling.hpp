@@ -0,0 +1,294 @@
+#ifndef __COASYNCPP_PROFILING_HPP__
+#define __COASYNCPP_PROFILING_HPP__
+
+#include <coroutine>
+#include <string_view>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The struct that represents the awaitable which names the current task, its run time and the run time of the
+/// tasks it creates afterwards are accounted under the name.
+struct set_name
+{
+    set_name(std::string_view name) : name_{name}
+    {
+    }
+    bool await_ready() noexcept
+    {
+        return true;
+    }
+    void await_suspend(std::coroutine_handle<>) noexcept
+    {
+    }
+    void await_resume() noexcept
+    {
+    }
+
+    std::string_view name_{};
+};
+} // namespace coasyncpp
+
+// The run time of the named tasks is accounted only when COASYNCPP_PROFILING is defined, otherwise the hooks are empty.
+#ifdef COASYNCPP_PROFILING
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The namespace that represents the accounting of the run time of the named tasks.
+namespace profile
+{
+/// @brief The class that represents the run time of all the tasks with the same name, charged by any thread.
+class account
+{
+  public:
+    account(std::string name) : name_{std::move(name)}
+    {
+    }
+
+    void charge(std::int64_t wall, std::int64_t cpu)
+    {
+        wall_.fetch_add(wall, std::memory_order_relaxed);
+        cpu_.fetch_add(cpu, std::memory_order_relaxed);
+        slices_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::string const name_;
+    // In nanoseconds.
+    std::atomic<std::int64_t> wall_{};
+    std::atomic<std::int64_t> cpu_{};
+    // The runs of the tasks between their resume and suspend points.
+    std::atomic<std::uint64_t> slices_{};
+};
+
+/// @brief The struct that represents the snapshot of the account.
+struct account_stats
+{
+    std::string name_{};
+    std::chrono::nanoseconds wall_{};
+    std::chrono::nanoseconds cpu_{};
+    std::uint64_t slices_{};
+};
+
+/// @brief The class that represents the registry of the accounts by name, the accounts are never removed.
+class registry
+{
+  public:
+    static registry &getInstance()
+    {
+        // Never destroyed, the workers may charge the accounts during the exit.
+        static registry *instance = new registry{};
+        return *instance;
+    }
+
+    account *get(std::string_view name)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        auto &found = accounts_[std::string{name}];
+        if (!found)
+            found = std::make_unique<account>(std::string{name});
+
+        return found.get();
+    }
+    std::vector<account_stats> take()
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+
+        std::vector<account_stats> taken{};
+        for (auto const &[name, account] : accounts_)
+        {
+            taken.push_back({name, std::chrono::nanoseconds{account->wall_.load(std::memory_order_relaxed)},
+                std::chrono::nanoseconds{account->cpu_.load(std::memory_order_relaxed)},
+                account->slices_.load(std::memory_order_relaxed)});
+        }
+
+        return taken;
+    }
+
+  private:
+    registry() = default;
+
+    std::mutex mutex_{};
+    std::unordered_map<std::string, std::unique_ptr<account>> accounts_{};
+};
+
+/// @brief The struct that represents the account the thread runs for and the clocks of the thread since it does.
+struct thread_state
+{
+    account *current_{};
+    std::int64_t wall_{};
+    std::int64_t cpu_{};
+};
+
+inline thread_state &local()
+{
+    thread_local thread_state state{};
+    return state;
+}
+
+inline std::int64_t wallNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/// @brief Returns the CPU time of the current thread, POSIX only.
+inline std::int64_t cpuNow()
+{
+    timespec now{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return std::int64_t{now.tv_sec} * 1000000000 + now.tv_nsec;
+}
+
+inline account *current()
+{
+    return local().current_;
+}
+
+/// @brief Charges the time since the previous switch to the account the thread runs for and switches to the next one.
+/// The clocks are read only when the account changes, so the unnamed tasks cost the compare only.
+inline void switchTo(account *next)
+{
+    auto &state = local();
+    if (next == state.current_)
+        return;
+
+    auto wall = wallNow();
+    auto cpu = cpuNow();
+    if (nullptr != state.current_)
+        state.current_->charge(wall - state.wall_, cpu - state.cpu_);
+
+    state = {next, wall, cpu};
+}
+
+/// @brief Returns the snapshot of all the accounts.
+inline std::vector<account_stats> snapshot()
+{
+    return registry::getInstance().take();
+}
+
+/// @brief Writes the accounts in the Prometheus text format.
+inline void dump(std::ostream &out)
+{
+    for (auto const &taken : snapshot())
+    {
+        auto label = "{name=\"" + taken.name_ + "\"}";
+        out << "coasyncpp_task_wall_seconds_total" << label << " " << taken.wall_.count() / 1e9 << "\n";
+        out << "coasyncpp_task_cpu_seconds_total" << label << " " << taken.cpu_.count() / 1e9 << "\n";
+        out << "coasyncpp_task_slices_total" << label << " " << taken.slices_ << "\n";
+    }
+}
+
+/// @brief Returns the awaiter of the awaitable, the result of its operator co_await if any.
+template <typename Awaitable> decltype(auto) getAwaiter(Awaitable &&awaitable)
+{
+    if constexpr (requires { std::forward<Awaitable>(awaitable).operator co_await(); })
+        return std::forward<Awaitable>(awaitable).operator co_await();
+    else
+        return static_cast<std::remove_reference_t<Awaitable> &>(awaitable);
+}
+
+/// @brief The class that represents the awaiter which stops charging the account of the task when it suspends and
+/// resumes charging it, on whatever thread, when it resumes.
+/// @tparam Awaiter The type of the wrapped awaiter, the reference if the awaitable lives in the co_await expression.
+template <typename Awaiter> class awaiter
+{
+  public:
+    awaiter(Awaiter wrapped, account *const &account) : wrapped_{std::forward<Awaiter>(wrapped)}, account_{account}
+    {
+    }
+    decltype(auto) await_ready()
+    {
+        return wrapped_.await_ready();
+    }
+    template <typename P> decltype(auto) await_suspend(std::coroutine_handle<P> handle)
+    {
+        // The task may be resumed by another thread as soon as it is suspended.
+        switchTo(nullptr);
+        return wrapped_.await_suspend(handle);
+    }
+    decltype(auto) await_resume()
+    {
+        switchTo(account_);
+        return wrapped_.await_resume();
+    }
+
+  private:
+    Awaiter wrapped_;
+    account *const &account_;
+};
+} // namespace profile
+
+/// @brief The class that represents the account of the async task, the base of its promise. The task is accounted under
+/// the account of the task which created it, unless it's named itself.
+class task_profile
+{
+  public:
+    /// @brief Names the task, its run time is accounted under the name from now on.
+    void rename(std::string_view name)
+    {
+        account_ = profile::registry::getInstance().get(name);
+    }
+
+    /// @brief Wraps every awaitable, so the task is charged between its resume and suspend points only.
+    template <typename Awaitable> auto await_transform(Awaitable &&awaitable)
+    {
+        using awaiter_type = decltype(profile::getAwaiter(std::forward<Awaitable>(awaitable)));
+        return profile::awaiter<awaiter_type>{profile::getAwaiter(std::forward<Awaitable>(awaitable)), account_};
+    }
+    std::suspend_never await_transform(set_name name)
+    {
+        rename(name.name_);
+        profile::switchTo(account_);
+        return {};
+    }
+    /// @brief Wraps the awaiter the promise suspends on, i.e. the initial one and the one of co_yield.
+    template <typename Awaiter> profile::awaiter<Awaiter> profiled(Awaiter awaiter)
+    {
+        return {std::move(awaiter), account_};
+    }
+
+  private:
+    profile::account *account_{profile::current()};
+};
+} // namespace coasyncpp
+
+#define COASYNCPP_PROFILE_LEAVE() ::coasyncpp::profile::switchTo(nullptr)
+
+#else
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The class that represents the account of the async task, empty since the profiling is off.
+class task_profile
+{
+  public:
+    void rename(std::string_view)
+    {
+    }
+    template <typename Awaiter> Awaiter profiled(Awaiter awaiter)
+    {
+        return awaiter;
+    }
+};
+} // namespace coasyncpp
+
+#define COASYNCPP_PROFILE_LEAVE()
+
+#endif
+
+#endif
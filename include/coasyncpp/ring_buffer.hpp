@@ -0,0 +1,86 @@
+#ifndef __COASYNCPP_RING_BUFFER_HPP__
+#define __COASYNCPP_RING_BUFFER_HPP__
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The class that represents lock-free single producer single consumer ring buffer.
+/// @tparam T The type of the buffer values.
+template <typename T> class spsc_ring_buffer
+{
+  public:
+    spsc_ring_buffer(std::size_t capacity) :
+        capacity_{capacity}, mask_{std::bit_ceil(capacity) - 1}, values_(std::bit_ceil(capacity))
+    {
+    }
+
+    /// @brief Pushes the value. Must be called from the producer thread only.
+    /// @return Returns false if the buffer is full.
+    template <typename U> bool tryPush(U &&value)
+    {
+        auto tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ == capacity_)
+        {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ == capacity_)
+                return false;
+        }
+
+        values_[tail & mask_] = std::forward<U>(value);
+        tail_.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+    /// @brief Pops the value. Must be called from the consumer thread only.
+    /// @return Returns false if the buffer is empty.
+    bool tryPop(T &value)
+    {
+        auto head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_)
+        {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_)
+                return false;
+        }
+
+        value = std::move(values_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /// @brief Checks the buffer is full. Exact from the producer thread only.
+    bool full() const
+    {
+        return tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_acquire) == capacity_;
+    }
+    /// @brief Checks the buffer is empty. Exact from the consumer thread only.
+    bool empty() const
+    {
+        return head_.load(std::memory_order_relaxed) == tail_.load(std::memory_order_acquire);
+    }
+    std::size_t capacity() const
+    {
+        return capacity_;
+    }
+
+  private:
+    std::size_t capacity_{};
+    std::size_t mask_{};
+    std::vector<T> values_{};
+
+    // Producer and consumer indexes live on the separate cache lines.
+    alignas(64) std::atomic<std::size_t> head_{};
+    std::size_t tailCache_{};
+    alignas(64) std::atomic<std::size_t> tail_{};
+    std::size_t headCache_{};
+};
+} // namespace coasyncpp
+
+#endif
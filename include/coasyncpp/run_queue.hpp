@@ -0,0 +1,167 @@
+#ifndef __COASYNCPP_RUN_QUEUE_HPP__
+#define __COASYNCPP_RUN_QUEUE_HPP__
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The enum that represents the priority class of the scheduled task.
+enum class task_priority : std::uint8_t
+{
+    // The interactive requests.
+    critical,
+    normal,
+    // The maintenance, e.g. the compaction, which must not delay the others.
+    background
+};
+
+inline constexpr std::size_t priorityCount{3};
+
+/// @brief The struct that represents the lane of the scheduled task: the priority class, or the deadline if any.
+struct task_lane
+{
+    task_priority priority_{task_priority::normal};
+    std::chrono::steady_clock::time_point deadline_{std::chrono::steady_clock::time_point::max()};
+
+    bool hasDeadline() const
+    {
+        return std::chrono::steady_clock::time_point::max() != deadline_;
+    }
+};
+
+/// @brief The class that represents the run queue with the FIFO lane per priority class and the earliest deadline first
+/// lane, the earliest deadline first within it. The lanes are dequeued by the weighted round robin, so every non-empty
+/// lane gets its share, deadline 16, critical 16, normal 4 and background 1 by default, the deadline lane first and
+/// then the higher classes first within the round, so neither the deadlines nor the classes starve each other. It's not
+/// thread safe.
+/// @tparam T The type of the item.
+template <typename T> class run_queue
+{
+  public:
+    void push(T item, task_priority priority)
+    {
+        lanes_[static_cast<std::size_t>(priority)].push_back(std::move(item));
+        ++size_;
+    }
+    void push(T item, std::chrono::steady_clock::time_point deadline)
+    {
+        deadlines_.push_back({deadline, sequence_++, std::move(item)});
+        std::push_heap(deadlines_.begin(), deadlines_.end(), std::greater<>{});
+        ++size_;
+    }
+    void push(T item, task_lane lane)
+    {
+        if (lane.hasDeadline())
+            push(std::move(item), lane.deadline_);
+        else
+            push(std::move(item), lane.priority_);
+    }
+    bool pop(T &item)
+    {
+        for (int round = 0; round < 2; ++round)
+        {
+            if (!deadlines_.empty() && 0 != deadlineCredits_)
+            {
+                --deadlineCredits_;
+                std::pop_heap(deadlines_.begin(), deadlines_.end(), std::greater<>{});
+                item = std::move(deadlines_.back().item_);
+                deadlines_.pop_back();
+                --size_;
+                return true;
+            }
+            for (std::size_t lane = 0; lane < priorityCount; ++lane)
+            {
+                if (lanes_[lane].empty() || 0 == credits_[lane])
+                    continue;
+
+                --credits_[lane];
+                item = std::move(lanes_[lane].front());
+                lanes_[lane].pop_front();
+                --size_;
+                return true;
+            }
+
+            // Every non-empty lane has spent its share, the next round starts.
+            credits_ = weights_;
+            deadlineCredits_ = deadlineWeight_;
+        }
+
+        return false;
+    }
+
+    /// @brief Returns the first item of the lane of the priority class which matches the predicate, null if none.
+    template <typename Predicate> T const *find(task_priority priority, Predicate predicate) const
+    {
+        auto const &lane = lanes_[static_cast<std::size_t>(priority)];
+        auto found = std::find_if(lane.begin(), lane.end(), predicate);
+        return lane.end() != found ? &*found : nullptr;
+    }
+    /// @brief Removes the first item of the lane of the priority class which matches the predicate, if any.
+    template <typename Predicate> bool remove(task_priority priority, T &item, Predicate predicate)
+    {
+        auto &lane = lanes_[static_cast<std::size_t>(priority)];
+        auto found = std::find_if(lane.begin(), lane.end(), predicate);
+        if (lane.end() == found)
+            return false;
+
+        item = std::move(*found);
+        lane.erase(found);
+        --size_;
+        return true;
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+    bool empty() const
+    {
+        return 0 == size_;
+    }
+    /// @brief Sets the shares of the priority classes and of the deadline lane within the round, at least 1 each.
+    void setWeights(std::array<std::size_t, priorityCount> weights, std::size_t deadlineWeight)
+    {
+        for (auto &weight : weights)
+            weight = std::max<std::size_t>(1, weight);
+
+        weights_ = weights;
+        credits_ = weights;
+        deadlineWeight_ = std::max<std::size_t>(1, deadlineWeight);
+        deadlineCredits_ = deadlineWeight_;
+    }
+
+  private:
+    /// @brief The struct that represents the item with the deadline, the same deadlines are FIFO.
+    struct deadline_item
+    {
+        std::chrono::steady_clock::time_point deadline_;
+        std::uint64_t sequence_;
+        T item_;
+
+        friend bool operator>(deadline_item const &lh, deadline_item const &rh)
+        {
+            return lh.deadline_ != rh.deadline_ ? lh.deadline_ > rh.deadline_ : lh.sequence_ > rh.sequence_;
+        }
+    };
+
+    std::array<std::deque<T>, priorityCount> lanes_{};
+    std::vector<deadline_item> deadlines_{};
+    std::array<std::size_t, priorityCount> weights_{16, 4, 1};
+    std::array<std::size_t, priorityCount> credits_{16, 4, 1};
+    std::size_t deadlineWeight_{16};
+    std::size_t deadlineCredits_{16};
+    std::uint64_t sequence_{};
+    std::size_t size_{};
+};
+} // namespace coasyncpp
+
+#endif
@@ -2,25 +2,102 @@
 #define __COASYNCPP_SCHEDULER_HPP__
 
 #include "common.hpp"
+#include "work_deque.hpp"
+#include "tracing.hpp"
+#include "stats.hpp"
+#include "run_queue.hpp"
+#include "admission.hpp"
+#include "topology.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <functional>
 #include <queue>
+#include <memory>
 #include <mutex>
 #include <condition_variable>
+#include <optional>
+#include <string>
 #include <thread>
 #include <expected>
+#include <vector>
 
 namespace coasyncpp
 {
-struct task_storage
+struct task_storage : std::enable_shared_from_this<task_storage>
 {
     task_storage(async_interface *task) : task_{task}
     {
     }
+    task_storage(std::shared_ptr<async_interface> task) : task_{task.get()}, owner_{std::move(task)}
+    {
+    }
+    task_storage(std::coroutine_handle<> handle) : task_{}, handle_{handle}
+    {
+    }
     async_interface *task_;
+    // The coroutine to resume exactly once, instead of the task to execute until done.
+    std::coroutine_handle<> handle_{};
+    // The coroutine of the chain of the task to resume once before the task steps on, see storageOf().
+    std::coroutine_handle<> resume_{};
+    // Keeps the task alive while it is scheduled, if the scheduler owns it.
+    std::shared_ptr<async_interface> owner_{};
+    std::chrono::steady_clock::time_point scheduledAt_{std::chrono::steady_clock::now()};
+    task_lane lane_{};
+    // Submitted through the admission control and not started yet.
+    bool isAdmitted_{};
+    // The result of the admission of the coroutine, set if it's shed.
+    std::expected<void, async_error> *admission_{};
     std::mutex mutex_{};
     std::condition_variable cv_{};
 };
 
+/// @brief The struct that represents the coroutine to resume at the given time.
+struct timer_storage
+{
+    std::chrono::steady_clock::time_point at_;
+    std::shared_ptr<task_storage> task_;
+    // The lane of the coroutine once the time comes.
+    task_lane lane_{};
+
+    // The earliest timer is on the top of the std::priority_queue.
+    friend bool operator>(timer_storage const &lh, timer_storage const &rh)
+    {
+        return lh.at_ > rh.at_;
+    }
+};
+
+/// @brief The struct that represents the queue of the tasks and the timers shared by the workers of the NUMA node.
+struct shard_storage
+{
+    std::mutex mutex_{};
+    run_queue<std::shared_ptr<task_storage>> tasks_{};
+    std::priority_queue<timer_storage, std::vector<timer_storage>, std::greater<>> timers_{};
+};
+
+/// @brief The struct that represents the worker thread with its local deque of the spawned coroutines.
+struct worker_storage
+{
+    std::size_t index_{};
+    // The shard of the NUMA node of the worker and the CPU it's pinned to with COASYNCPP_PIN_WORKERS defined.
+    std::size_t shard_{};
+    int cpu_{};
+    // The workers to steal from, the ones of the same node first.
+    std::vector<std::size_t> stealOrder_{};
+    work_deque<void *> deque_{};
+    std::thread thread_{};
+    worker_counters counters_{};
+    // The coroutine the worker runs and its resume function, null for the task step, and the start of its run slice,
+    // zero if the worker is between the slices.
+    std::atomic<void *> running_{};
+    std::atomic<void *> runningCode_{};
+    std::atomic<std::int64_t> runningSince_{};
+    // The calls of yield_if_needed, the clock is read only on every yieldCheckInterval call.
+    std::size_t yieldChecks_{};
+};
+
 class Scheduler
 {
   public:
@@ -34,76 +111,841 @@ class Scheduler
     ~Scheduler()
     {
         isRunning_ = false;
-        workerThread_.join();
+        for (auto &worker : workers_)
+            worker->thread_.join();
     }
 
-    void schedule(async_interface *task, bool blockThread = false)
+    void schedule(async_interface *task, bool blockThread = false, task_priority priority = task_priority::normal)
     {
         // TODO: replace tasks_ with lock free one.
         auto ts = std::make_shared<task_storage>(task);
+        ts->lane_.priority_ = priority;
+        countScheduled();
         std::unique_lock lock(ts->mutex_);
         {
-            std::lock_guard tasksLock{tasksMutex_};
-            tasks_.push(ts);
+            auto &shard = *shards_[targetShard()];
+            std::lock_guard tasksLock{shard.mutex_};
+            shard.tasks_.push(ts, ts->lane_);
         }
         // Suspend thread
         if (blockThread)
             ts->cv_.wait(lock, [task]() { return task->done(); });
     }
+    void schedule(std::shared_ptr<async_interface> task, task_priority priority = task_priority::normal)
+    {
+        enqueue(std::make_shared<task_storage>(std::move(task)), {priority});
+    }
+    /// @brief Resumes the coroutine on the worker, in the lane of the current run slice if called from the worker.
+    void schedule(std::coroutine_handle<> handle)
+    {
+        enqueue(storageOf(handle), currentLane_);
+    }
+    void schedule(std::coroutine_handle<> handle, task_priority priority)
+    {
+        enqueue(storageOf(handle), {priority});
+    }
+    /// @brief Resumes the coroutine on the worker in the earliest deadline first lane, before the later deadlines.
+    void scheduleBefore(std::chrono::steady_clock::time_point deadline, std::coroutine_handle<> handle)
+    {
+        enqueue(storageOf(handle), {task_priority::critical, deadline});
+    }
+    void scheduleBefore(std::chrono::steady_clock::time_point deadline, std::shared_ptr<async_interface> task)
+    {
+        enqueue(std::make_shared<task_storage>(std::move(task)), {task_priority::critical, deadline});
+    }
+    /// @brief Resumes the coroutine on the worker of the shard, e.g. the one of the NUMA node its data is on, in the
+    /// lane of the current run slice.
+    void scheduleOn(std::size_t shard, std::coroutine_handle<> handle)
+    {
+        enqueue(storageOf(handle), currentLane_, shard % shards_.size());
+    }
+    void scheduleOn(std::size_t shard, std::coroutine_handle<> handle, task_priority priority)
+    {
+        enqueue(storageOf(handle), {priority}, shard % shards_.size());
+    }
+    /// @brief Resumes the coroutine on the worker once the time comes, in the lane of the current run slice.
+    void scheduleAt(std::chrono::steady_clock::time_point at, std::coroutine_handle<> handle)
+    {
+        auto &shard = *shards_[targetShard()];
+        std::lock_guard tasksLock{shard.mutex_};
+        shard.timers_.push({at, storageOf(handle), currentLane_});
+    }
+    /// @brief Returns the storage to queue the suspended coroutine with. The coroutine of the chain of the task the worker
+    /// executes the step of is queued with the task itself, so the task is not stepped on, i.e. resumed twice, until
+    /// the coroutine is resumed.
+    std::shared_ptr<task_storage> storageOf(std::coroutine_handle<> handle)
+    {
+        if (nullptr == currentStep_ || isStepParked_ || !isOfStep(handle))
+            return std::make_shared<task_storage>(handle);
+
+        isStepParked_ = true;
+        currentStep_->resume_ = handle;
+        currentStep_->scheduledAt_ = std::chrono::steady_clock::now();
+        return currentStep_->shared_from_this();
+    }
+    /// @brief Sets the shares of the critical, normal and background priority classes and of the earliest deadline
+    /// first lane in the global queue, 16, 4, 1 and 16 by default.
+    void setPriorityWeights(std::array<std::size_t, priorityCount> weights, std::size_t deadlineWeight = 16)
+    {
+        for (auto &shard : shards_)
+        {
+            std::lock_guard tasksLock{shard->mutex_};
+            shard->tasks_.setWeights(weights, deadlineWeight);
+        }
+    }
+    /// @brief Sets the admission control of the submitted tasks, see submit() and admit().
+    void setAdmission(admission_config config)
+    {
+        std::lock_guard admissionLock{admissionMutex_};
+        admission_ = config;
+        delayMonitor_.configure(config.target_, config.interval_);
+        isDelayMonitored_ = 0 != config.target_.count();
+    }
+    /// @brief Schedules the task in the lane of the priority class if the global queue admits it. The scheduler owns
+    /// the task, the shed one is dropped without its completion.
+    std::expected<void, async_error> submit(std::shared_ptr<async_interface> task,
+        task_priority priority = task_priority::normal)
+    {
+        return submit(priority, [&task]() { return std::make_shared<task_storage>(std::move(task)); });
+    }
+    /// @brief Resumes the coroutine in the lane of the priority class if the global queue admits it, the shed one is
+    /// resumed with the error set to the result of the admission.
+    std::expected<void, async_error> submit(std::coroutine_handle<> handle, task_priority priority,
+        std::expected<void, async_error> *admission)
+    {
+        return submit(priority, [this, handle, admission]() {
+            auto taskStorage = storageOf(handle);
+            taskStorage->admission_ = admission;
+            return taskStorage;
+        });
+    }
+    /// @brief Resumes the coroutine on the worker. Called from the worker it pushes the coroutine to the local deque
+    /// without any allocation or lock, the idle workers steal from there. Otherwise it's the same as schedule().
+    void spawn(std::coroutine_handle<> handle)
+    {
+        if (nullptr != currentWorker_)
+        {
+            worker_counters::increment(currentWorker_->counters_.scheduled_);
+            currentWorker_->deque_.push(handle.address());
+        }
+        else
+            schedule(handle);
+    }
     void resumeFromCallback(task_storage *taskStorage)
     {
         std::lock_guard lock{taskStorage->mutex_};
         taskStorage->cv_.notify_one();
     }
+    /// @brief Returns the snapshot of the counters of the workers and the queues, cheap enough to call periodically.
+    scheduler_stats stats()
+    {
+        scheduler_stats taken{};
+        for (auto &worker : workers_)
+        {
+            auto &counters = worker->counters_;
+            taken.workers_.push_back({worker->index_, counters.scheduled_.load(std::memory_order_relaxed),
+                counters.executed_.load(std::memory_order_relaxed), counters.steals_.load(std::memory_order_relaxed),
+                counters.idle_.load(std::memory_order_relaxed), worker->deque_.size(), counters.queueLatency_.take(),
+                counters.runSlices_.take(), worker->shard_, worker->cpu_});
+        }
+        taken.externalScheduled_ = externalScheduled_.load(std::memory_order_relaxed);
+
+        std::lock_guard admissionLock{admissionMutex_};
+        taken.admission_ = {admitted_, rejected_, shed_, admittedQueued_, isOverloaded()};
+        for (auto &shard : shards_)
+        {
+            std::lock_guard tasksLock{shard->mutex_};
+            taken.globalQueueDepth_ += shard->tasks_.size();
+            taken.timers_ += shard->timers_.size();
+        }
+
+        return taken;
+    }
+    /// @brief Returns the run slices in progress on the workers, e.g. to find the ones over the budget.
+    std::vector<running_slice> runningSlices()
+    {
+        std::vector<running_slice> running{};
+        auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        for (auto &worker : workers_)
+        {
+            auto since = worker->runningSince_.load(std::memory_order_acquire);
+            if (0 != since)
+            {
+                running.push_back({worker->index_, worker->running_.load(std::memory_order_relaxed),
+                    worker->runningCode_.load(std::memory_order_relaxed), since,
+                    std::chrono::steady_clock::duration{now - since}});
+            }
+        }
+
+        return running;
+    }
+    /// @brief Returns true if the current run slice of the worker is longer than the budget. It reads the clock only
+    /// on every yieldCheckInterval call, and it's always false outside of the workers.
+    bool isSliceOver(std::chrono::steady_clock::duration budget)
+    {
+        auto self = currentWorker_;
+        if (nullptr == self || 0 != ++self->yieldChecks_ % yieldCheckInterval)
+            return false;
+
+        auto since = self->runningSince_.load(std::memory_order_relaxed);
+        return 0 != since && std::chrono::steady_clock::now().time_since_epoch().count() - since >= budget.count();
+    }
+    /// @brief Moves the coroutines queued on the local deque of the worker to the global queue, so the other workers
+    /// run them while the worker is busy.
+    /// @return Returns the count of the moved coroutines.
+    std::size_t migrate(std::size_t index)
+    {
+        std::size_t count{};
+        void *address{};
+        while (workers_[index]->deque_.steal(address))
+        {
+            scheduleOn(workers_[index]->shard_, std::coroutine_handle<>::from_address(address));
+            ++count;
+        }
+
+        return count;
+    }
+    /// @brief Returns the count of the shards of the global queue, one per NUMA node with any worker.
+    std::size_t shardCount() const
+    {
+        return shards_.size();
+    }
+    /// @brief Returns the shard of the current worker, the one the tasks it schedules go to, 0 outside of the
+    /// workers.
+    std::size_t currentShard() const
+    {
+        return nullptr != currentWorker_ ? currentWorker_->shard_ : 0;
+    }
+    /// @brief Returns the count of the worker threads, one per CPU the process is allowed to run on.
+    std::size_t workerCount() const
+    {
+        return workers_.size();
+    }
 
   private:
     static Scheduler *instance_;
+    static inline thread_local worker_storage *currentWorker_{};
+    // The lane of the task the worker runs from the global queue.
+    static inline thread_local task_lane currentLane_{};
+    // The task the worker executes the step of and whether the step is queued already, see storageOf().
+    static inline thread_local task_storage *currentStep_{};
+    static inline thread_local bool isStepParked_{};
+
+    // The global queue and the timers are checked once per this count of the local coroutines, to not starve them.
+    static constexpr std::size_t globalCheckInterval{64};
+    // The run slice budget is checked once per this count of the calls of yield_if_needed.
+    static constexpr std::size_t yieldCheckInterval{16};
 
     Scheduler()
     {
         isRunning_ = true;
-        workerThread_ = std::thread(&Scheduler::worker, this);
-    }
 
-    std::queue<std::shared_ptr<task_storage>> tasks_{};
-    bool isRunning_{};
-    std::thread workerThread_{};
-    std::mutex tasksMutex_{};
+        // The worker per CPU the process is allowed to run on, node by node, the shard per node with any worker, so
+        // the pinned workers don't share the CPUs in the restricted cpuset.
+        auto topology = detectTopology();
+        std::vector<std::pair<int, std::size_t>> cpus{};
+        for (std::size_t node = 0; node < topology.nodes_.size(); ++node)
+        {
+            for (auto cpu : topology.nodes_[node])
+                cpus.push_back({cpu, node});
+        }
+        auto count = cpus.size();
+        std::vector<std::size_t> shardOfNode(topology.nodes_.size(), topology.nodes_.size());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto [cpu, node] = cpus[i];
+            if (topology.nodes_.size() == shardOfNode[node])
+            {
+                shardOfNode[node] = shards_.size();
+                shards_.push_back(std::make_unique<shard_storage>());
+            }
 
-    void worker()
-    {
-        while (isRunning_)
+            workers_.push_back(std::make_unique<worker_storage>());
+            workers_.back()->index_ = i;
+            workers_.back()->shard_ = shardOfNode[node];
+            workers_.back()->cpu_ = cpu;
+        }
+        for (auto &worker : workers_)
         {
-            while (isRunning_ && !tasks_.empty())
+            for (auto isSameShard : {true, false})
             {
-                auto taskStorage = tasks_.front();
+                for (std::size_t i = 1; i < workers_.size(); ++i)
                 {
-                    std::lock_guard lock{tasksMutex_};
-                    tasks_.pop();
+                    auto &other = workers_[(worker->index_ + i) % workers_.size()];
+                    if (isSameShard == (other->shard_ == worker->shard_))
+                        worker->stealOrder_.push_back(other->index_);
                 }
+            }
+        }
+        // Started once all the deques exist, since the workers steal from each other.
+        for (auto &worker : workers_)
+            worker->thread_ = std::thread(&Scheduler::worker, this, worker.get());
+    }
 
-                if (taskStorage->task_->done())
-                {
-                    std::lock_guard lock{taskStorage->mutex_};
-                    taskStorage->cv_.notify_one();
-                }
-                else
+    // The global queue sharded per NUMA node, the workers run the tasks of their own shard first.
+    std::vector<std::unique_ptr<shard_storage>> shards_{};
+    std::atomic<std::size_t> nextShard_{};
+    std::atomic<bool> isRunning_{};
+    std::vector<std::unique_ptr<worker_storage>> workers_{};
+    std::atomic<std::uint64_t> externalScheduled_{};
+    // The admission control, locked before the shards.
+    std::mutex admissionMutex_{};
+    std::atomic<bool> isDelayMonitored_{};
+    admission_config admission_{};
+    queue_delay_monitor delayMonitor_{};
+    std::condition_variable admissionCv_{};
+    std::size_t admittedQueued_{};
+    std::size_t blocked_{};
+    std::uint64_t admitted_{};
+    std::uint64_t rejected_{};
+    std::uint64_t shed_{};
+
+    /// @brief Returns the shard of the current worker, otherwise the next one in turn.
+    std::size_t targetShard()
+    {
+        if (nullptr != currentWorker_)
+            return currentWorker_->shard_;
+
+        return 1 == shards_.size() ? 0 : nextShard_.fetch_add(1, std::memory_order_relaxed) % shards_.size();
+    }
+    void enqueue(std::shared_ptr<task_storage> taskStorage, task_lane lane)
+    {
+        enqueue(std::move(taskStorage), lane, targetShard());
+    }
+    void enqueue(std::shared_ptr<task_storage> taskStorage, task_lane lane, std::size_t index)
+    {
+        taskStorage->lane_ = lane;
+        countScheduled();
+        auto &shard = *shards_[index];
+        std::lock_guard tasksLock{shard.mutex_};
+        shard.tasks_.push(std::move(taskStorage), lane);
+    }
+    /// @brief Schedules the task storage made by the callable if the global queue admits it, with the policy of the
+    /// admission control if the queue is overloaded, i.e. it's at the capacity or its delay is persistently over the
+    /// target.
+    template <typename Make> std::expected<void, async_error> submit(task_priority priority, Make &&make)
+    {
+        std::unique_lock admissionLock{admissionMutex_};
+        while (isOverloaded())
+        {
+            if (overload_policy::block == admission_.policy_ && nullptr == currentWorker_)
+            {
+                ++blocked_;
+                admissionCv_.wait_for(admissionLock, std::chrono::milliseconds{1});
+                --blocked_;
+            }
+            else if ((overload_policy::shed_oldest != admission_.policy_ &&
+                         overload_policy::shed_lowest != admission_.policy_) ||
+                     !shed(priority))
+            {
+                ++rejected_;
+                return std::unexpected(async_error{overloadedErrorCode, "The Scheduler queue is overloaded."});
+            }
+            else
+                break;
+        }
+
+        // Made only once it's admitted, since the coroutine of the step parks the step.
+        auto taskStorage = make();
+        taskStorage->lane_ = {priority};
+        taskStorage->isAdmitted_ = true;
+        ++admittedQueued_;
+        ++admitted_;
+        {
+            auto &shard = *shards_[targetShard()];
+            std::lock_guard tasksLock{shard.mutex_};
+            shard.tasks_.push(taskStorage, taskStorage->lane_);
+        }
+        admissionLock.unlock();
+        countScheduled();
+
+        return {};
+    }
+    /// @brief Returns true if the coroutine is in the chain of the task the worker executes the step of, i.e. it's the
+    /// task or any task it awaits.
+    bool isOfStep(std::coroutine_handle<> handle)
+    {
+        for (auto frame = currentStep_->task_->taskFrame(); nullptr != frame; frame = frame->callee_)
+        {
+            if (handle.address() == frame->address_)
+                return true;
+        }
+
+        return false;
+    }
+    /// @brief Returns true if the global queue admits no more tasks. Called under the admissionMutex_.
+    bool isOverloaded() const
+    {
+        return (0 != admission_.capacity_ && admittedQueued_ >= admission_.capacity_) ||
+               delayMonitor_.isOverloaded();
+    }
+    /// @brief Sheds the admitted task to admit the one of the priority class. The shed coroutine is resumed in the
+    /// critical lane of its shard with the error, to fail fast, the shed task is dropped. Called under the
+    /// admissionMutex_.
+    /// @return Returns false if there is no task to shed.
+    bool shed(task_priority priority)
+    {
+        auto isAdmitted = [](auto const &queued) { return queued->isAdmitted_; };
+
+        std::shared_ptr<task_storage> victim{};
+        shard_storage *victimShard{};
+        if (overload_policy::shed_lowest == admission_.policy_)
+        {
+            for (auto lane = priorityCount; !victim && lane-- > static_cast<std::size_t>(priority);)
+            {
+                for (auto &shard : shards_)
                 {
+                    std::lock_guard tasksLock{shard->mutex_};
+                    if (shard->tasks_.remove(static_cast<task_priority>(lane), victim, isAdmitted))
                     {
-                        std::lock_guard lock{tasksMutex_};
-                        tasks_.push(taskStorage);
+                        victimShard = shard.get();
+                        break;
                     }
-                    taskStorage->task_->execute();
                 }
             }
-            if (isRunning_)
-                std::this_thread::yield();
         }
+        else
+        {
+            // The shard of the oldest one is found first, the shards are not locked together.
+            std::optional<std::chrono::steady_clock::time_point> oldestAt{};
+            for (auto &shard : shards_)
+            {
+                std::lock_guard tasksLock{shard->mutex_};
+                if (auto found = oldest(*shard, isAdmitted); found && (!oldestAt || found->first < *oldestAt))
+                {
+                    oldestAt = found->first;
+                    victimShard = shard.get();
+                }
+            }
+            if (nullptr != victimShard)
+            {
+                std::lock_guard tasksLock{victimShard->mutex_};
+                if (auto found = oldest(*victimShard, isAdmitted))
+                    victimShard->tasks_.remove(found->second, victim, isAdmitted);
+            }
+        }
+        if (!victim)
+            return false;
+
+        victim->isAdmitted_ = false;
+        --admittedQueued_;
+        ++shed_;
+        if (nullptr != victim->admission_)
+        {
+            *victim->admission_ = std::unexpected(async_error{overloadedErrorCode, "The task is shed by the Scheduler."});
+            victim->lane_ = {task_priority::critical};
+            std::lock_guard tasksLock{victimShard->mutex_};
+            victimShard->tasks_.push(std::move(victim), task_priority::critical);
+        }
+
+        return true;
+    }
+    /// @brief Returns the time the oldest admitted task of the shard is queued at and its lane, if any. Called under
+    /// the mutex of the shard.
+    template <typename Predicate>
+    std::optional<std::pair<std::chrono::steady_clock::time_point, task_priority>> oldest(shard_storage &shard,
+        Predicate isAdmitted)
+    {
+        std::optional<std::pair<std::chrono::steady_clock::time_point, task_priority>> found{};
+        for (std::size_t lane = 0; lane < priorityCount; ++lane)
+        {
+            auto queued = shard.tasks_.find(static_cast<task_priority>(lane), isAdmitted);
+            if (nullptr != queued && (!found || (*queued)->scheduledAt_ < found->first))
+                found = {(*queued)->scheduledAt_, static_cast<task_priority>(lane)};
+        }
+
+        return found;
+    }
+    void countScheduled()
+    {
+        if (nullptr != currentWorker_)
+            worker_counters::increment(currentWorker_->counters_.scheduled_);
+        else
+            externalScheduled_.fetch_add(1, std::memory_order_relaxed);
+    }
+    /// @brief Runs the coroutine or the task step, measuring the run slice.
+    template <typename Run> void runSlice(worker_storage *self, void *address, Run &&run)
+    {
+        auto start = std::chrono::steady_clock::now();
+        self->running_.store(address, std::memory_order_relaxed);
+        // The frame of GCC, Clang and MSVC starts with the pointer to the resume function.
+        self->runningCode_.store(nullptr != address ? *static_cast<void **>(address) : nullptr,
+            std::memory_order_relaxed);
+        self->runningSince_.store(start.time_since_epoch().count(), std::memory_order_release);
+        run();
+        self->runningSince_.store(0, std::memory_order_relaxed);
+        self->counters_.runSlices_.record(std::chrono::steady_clock::now() - start);
+        worker_counters::increment(self->counters_.executed_);
+    }
+
+    void worker(worker_storage *self)
+    {
+        currentWorker_ = self;
+        COASYNCPP_TRACE_THREAD("worker " + std::to_string(self->index_));
+#ifdef COASYNCPP_PIN_WORKERS
+        pinCurrentThread(self->cpu_);
+#endif
+        auto &home = *shards_[self->shard_];
+
+        for (std::size_t tick = 1; isRunning_; ++tick)
+        {
+            if ((0 == tick % globalCheckInterval || self->deque_.empty()) && runQueued(self, home))
+                continue;
+
+            void *address{};
+            if (self->deque_.pop(address) || steal(self, address))
+            {
+                auto handle = std::coroutine_handle<>::from_address(address);
+                currentLane_ = {};
+                COASYNCPP_TRACE_SLICE(handle);
+                runSlice(self, address, [handle]() { handle.resume(); });
+                continue;
+            }
+            // The shards of the other nodes are helped only when there is no work on the own node.
+            if (runRemote(self))
+                continue;
+
+            worker_counters::increment(self->counters_.idle_);
+            std::this_thread::yield();
+        }
+    }
+    /// @brief Runs the next task of the shard of any other node, if any.
+    bool runRemote(worker_storage *self)
+    {
+        for (std::size_t i = 1; i < shards_.size(); ++i)
+        {
+            if (runQueued(self, *shards_[(self->shard_ + i) % shards_.size()]))
+                return true;
+        }
+
+        return false;
+    }
+    /// @brief Runs the next task of the shard of the global queue, if any.
+    bool runQueued(worker_storage *self, shard_storage &shard)
+    {
+        std::shared_ptr<task_storage> taskStorage{};
+        std::chrono::steady_clock::time_point now{};
+        bool isDrained{};
+        {
+            std::lock_guard lock{shard.mutex_};
+            pollTimers(shard);
+            if (!shard.tasks_.pop(taskStorage))
+                return false;
+
+            now = std::chrono::steady_clock::now();
+            isDrained = shard.tasks_.empty();
+        }
+        if (taskStorage->isAdmitted_ || isDelayMonitored_.load(std::memory_order_relaxed))
+        {
+            std::lock_guard admissionLock{admissionMutex_};
+            delayMonitor_.onDequeue(now - taskStorage->scheduledAt_, now, isDrained);
+            if (taskStorage->isAdmitted_)
+            {
+                // The started task is not the subject of the admission anymore, even if its steps are requeued.
+                taskStorage->isAdmitted_ = false;
+                --admittedQueued_;
+                if (0 != blocked_)
+                    admissionCv_.notify_one();
+            }
+        }
+        // The coroutines it schedules or delays stay in its lane, the ones it spawns to the local deque don't.
+        currentLane_ = taskStorage->lane_;
+
+        self->counters_.queueLatency_.record(now - taskStorage->scheduledAt_);
+
+        if (taskStorage->handle_)
+        {
+            COASYNCPP_TRACE_SLICE(taskStorage->handle_);
+            runSlice(self, taskStorage->handle_.address(), [&taskStorage]() { taskStorage->handle_.resume(); });
+        }
+        else if (auto handle = std::exchange(taskStorage->resume_, {}))
+            runStep(self, shard, taskStorage, handle, [handle]() { handle.resume(); });
+        else if (taskStorage->task_->done())
+        {
+            std::lock_guard lock{taskStorage->mutex_};
+            taskStorage->cv_.notify_one();
+        }
+        else
+            runStep(self, shard, taskStorage, {}, [&taskStorage]() { taskStorage->task_->execute(); });
+
+        return true;
+    }
+    /// @brief Runs the step of the task and pushes the task back, unless the coroutine of its chain queued it with
+    /// itself during the step. Pushed back only after the step, so no other worker executes the same task
+    /// concurrently.
+    template <typename Run>
+    void runStep(worker_storage *self, shard_storage &shard, std::shared_ptr<task_storage> const &taskStorage,
+        std::coroutine_handle<> handle, Run &&run)
+    {
+        currentStep_ = taskStorage.get();
+        isStepParked_ = false;
+        {
+            COASYNCPP_TRACE_SLICE(handle);
+            runSlice(self, handle.address(), std::forward<Run>(run));
+        }
+        currentStep_ = nullptr;
+        // The other worker may resume the queued coroutine already.
+        if (isStepParked_)
+            return;
+
+        taskStorage->scheduledAt_ = std::chrono::steady_clock::now();
+        std::lock_guard lock{shard.mutex_};
+        shard.tasks_.push(taskStorage, taskStorage->lane_);
+    }
+    /// @brief Moves the timers of the shard which time has come to its queue. Called under the mutex of the shard.
+    void pollTimers(shard_storage &shard)
+    {
+        if (shard.timers_.empty())
+            return;
+
+        auto now = std::chrono::steady_clock::now();
+        while (!shard.timers_.empty() && shard.timers_.top().at_ <= now)
+        {
+            auto taskStorage = shard.timers_.top().task_;
+            // The latency of the timer is counted from its deadline.
+            taskStorage->scheduledAt_ = shard.timers_.top().at_;
+            taskStorage->lane_ = shard.timers_.top().lane_;
+            shard.tasks_.push(std::move(taskStorage), shard.timers_.top().lane_);
+            shard.timers_.pop();
+        }
+    }
+    /// @brief Steals the coroutine from the deque of any other worker, the ones of the same node first.
+    bool steal(worker_storage *self, void *&address)
+    {
+        for (auto index : self->stealOrder_)
+        {
+            if (workers_[index]->deque_.steal(address))
+            {
+                worker_counters::increment(self->counters_.steals_);
+                return true;
+            }
+        }
+
+        return false;
     }
 };
 
 Scheduler *Scheduler::instance_{};
 
+/// @brief The class that represents fire and forget coroutine. It starts on the Scheduler worker and destroys itself
+/// on completion.
+struct detached_task
+{
+    struct promise_type : frame_allocator
+    {
+        /// @brief The class that represents an awaiter which moves the coroutine start to the Scheduler worker.
+        struct schedule_awaiter
+        {
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                Scheduler::getInstance()->schedule(handle);
+            }
+            void await_resume() noexcept
+            {
+            }
+        };
+
+        schedule_awaiter initial_suspend()
+        {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+        void return_void()
+        {
+        }
+        void unhandled_exception()
+        {
+        }
+        detached_task get_return_object()
+        {
+            return {};
+        }
+    };
+};
+
+/// @brief The class that represents an awaiter which resumes the coroutine on the Scheduler worker at the given time.
+class delay_awaiter
+{
+  public:
+    delay_awaiter(std::chrono::steady_clock::time_point at) : at_{at}
+    {
+    }
+    bool await_ready() const noexcept
+    {
+        return std::chrono::steady_clock::now() >= at_;
+    }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        Scheduler::getInstance()->scheduleAt(at_, handle);
+    }
+    void await_resume() noexcept
+    {
+    }
+
+  private:
+    std::chrono::steady_clock::time_point at_;
+};
+
+/// @brief Suspends the coroutine until the given time without blocking the thread.
+inline delay_awaiter delayUntil(std::chrono::steady_clock::time_point at)
+{
+    return {at};
+}
+/// @brief Suspends the coroutine for the given duration without blocking the thread.
+template <typename Rep, typename Period> delay_awaiter delay(std::chrono::duration<Rep, Period> duration)
+{
+    return {std::chrono::steady_clock::now() + std::chrono::ceil<std::chrono::steady_clock::duration>(duration)};
+}
+
+/// @brief The class that represents an awaiter which continues the coroutine inline while the run slice of the worker
+/// is within the budget, otherwise it requeues the coroutine at the back of the global queue, so the other coroutines
+/// run meanwhile.
+class yield_awaiter
+{
+  public:
+    yield_awaiter(std::chrono::steady_clock::duration budget) : budget_{budget}
+    {
+    }
+    bool await_ready()
+    {
+        return !Scheduler::getInstance()->isSliceOver(budget_);
+    }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        Scheduler::getInstance()->schedule(handle);
+    }
+    void await_resume() noexcept
+    {
+    }
+
+  private:
+    std::chrono::steady_clock::duration budget_;
+};
+
+/// @brief The class that represents an awaiter which moves the coroutine to the lane of the global queue.
+class reschedule_awaiter
+{
+  public:
+    reschedule_awaiter(task_lane lane) : lane_{lane}
+    {
+    }
+    bool await_ready() noexcept
+    {
+        return false;
+    }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        if (lane_.hasDeadline())
+            Scheduler::getInstance()->scheduleBefore(lane_.deadline_, handle);
+        else
+            Scheduler::getInstance()->schedule(handle, lane_.priority_);
+    }
+    void await_resume() noexcept
+    {
+    }
+
+  private:
+    task_lane lane_;
+};
+
+/// @brief The class that represents an awaiter which resumes the coroutine in the lane of the global queue if the
+/// admission control admits it, see Scheduler::setAdmission(). The rejected coroutine continues inline, the shed one is
+/// resumed with the error once it's shed.
+class admission_awaiter
+{
+  public:
+    admission_awaiter(task_priority priority) : priority_{priority}
+    {
+    }
+    bool await_ready() noexcept
+    {
+        return false;
+    }
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        // The admitted coroutine may be resumed by the worker at once, so the awaiter is not touched after that.
+        auto submitted = Scheduler::getInstance()->submit(handle, priority_, &result_);
+        if (submitted)
+            return true;
+
+        result_ = std::move(submitted);
+        return false;
+    }
+    std::expected<void, async_error> await_resume()
+    {
+        return std::move(result_);
+    }
+
+  private:
+    task_priority priority_;
+    std::expected<void, async_error> result_{};
+};
+
+/// @brief Resumes the coroutine in the lane of the priority class if the Scheduler queue admits it, otherwise returns
+/// the async_error with the overloadedErrorCode.
+inline admission_awaiter admit(task_priority priority = task_priority::normal)
+{
+    return {priority};
+}
+
+/// @brief The class that represents an awaiter which moves the coroutine to the shard of the global queue.
+class shard_awaiter
+{
+  public:
+    shard_awaiter(std::size_t shard) : shard_{shard}
+    {
+    }
+    bool await_ready() noexcept
+    {
+        return false;
+    }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        Scheduler::getInstance()->scheduleOn(shard_, handle);
+    }
+    void await_resume() noexcept
+    {
+    }
+
+  private:
+    std::size_t shard_;
+};
+
+/// @brief Resumes the coroutine on the worker of the shard, the coroutines it schedules or delays afterwards stay
+/// there.
+inline shard_awaiter resumeOnShard(std::size_t shard)
+{
+    return {shard};
+}
+
+/// @brief Resumes the coroutine in the lane of the priority class, it stays there when it's scheduled, delayed or
+/// yields afterwards.
+inline reschedule_awaiter reschedule(task_priority priority)
+{
+    return {{priority}};
+}
+/// @brief Resumes the coroutine in the earliest deadline first lane, it stays there when it's scheduled, delayed or
+/// yields afterwards.
+inline reschedule_awaiter reschedule(std::chrono::steady_clock::time_point deadline)
+{
+    return {{task_priority::critical, deadline}};
+}
+
+/// @brief Yields the worker to the other coroutines if the current run slice is longer than the budget, to call in the
+/// long loops without the suspension points, e.g. the generators.
+template <typename Rep = std::int64_t, typename Period = std::milli>
+yield_awaiter yield_if_needed(std::chrono::duration<Rep, Period> budget = std::chrono::milliseconds{1})
+{
+    return {std::chrono::ceil<std::chrono::steady_clock::duration>(budget)};
+}
+
 // Tasks with callback support
 template <typename T> struct awake_handle
 {
@@ -0,0 +1,250 @@
+#ifndef __COASYNCPP_SHARED_TASK_HPP__
+#define __COASYNCPP_SHARED_TASK_HPP__
+
+#include "common.hpp"
+#include "scheduler.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The class that represents the coroutine which runs the work of the shared task once. It is started by the
+/// first awaiter and destroys itself when complete.
+struct shared_runner
+{
+    struct promise_type : frame_allocator
+    {
+        std::suspend_always initial_suspend()
+        {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+        void return_void()
+        {
+        }
+        void unhandled_exception()
+        {
+            std::terminate();
+        }
+        shared_runner get_return_object()
+        {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+    };
+
+    std::coroutine_handle<promise_type> handle_{};
+};
+
+/// @brief The struct that represents the coroutine waiting for the shared task, the node of the intrusive waiter list.
+/// It lives in the frame of the waiting coroutine.
+struct shared_waiter
+{
+    std::coroutine_handle<> handle_{};
+    shared_waiter *next_{};
+};
+
+/// @brief The class that represents the state of the shared task: the work, its result and the waiters. The head of
+/// the waiter list also encodes the state: nullptr while not started, the address of the state once complete.
+/// @tparam T The type of the shared task result.
+template <typename T> class shared_state : public std::enable_shared_from_this<shared_state<T>>
+{
+  public:
+    ~shared_state()
+    {
+        // The started runner destroys itself.
+        if (nullptr == head_.load(std::memory_order_acquire))
+            runner_.destroy();
+    }
+
+    void setRunner(std::coroutine_handle<> runner)
+    {
+        runner_ = runner;
+    }
+    /// @brief Moves the state to the started one.
+    /// @return Returns the runner to resume, if the work wasn't started yet, the empty handle otherwise.
+    std::coroutine_handle<> start()
+    {
+        void *expected = nullptr;
+        if (!head_.compare_exchange_strong(expected, started(), std::memory_order_acq_rel, std::memory_order_acquire))
+            return {};
+
+        keepAlive_ = this->shared_from_this();
+        return runner_;
+    }
+    /// @brief Pushes the waiter to the list, starts the work if it is the first one.
+    /// @return Returns false if the result is ready and the waiter shouldn't be suspended.
+    bool wait(shared_waiter &waiter, std::coroutine_handle<> &next)
+    {
+        next = std::noop_coroutine();
+        auto head = head_.load(std::memory_order_acquire);
+        while (true)
+        {
+            if (completed() == head)
+                return false;
+
+            waiter.next_ = (nullptr == head || started() == head) ? nullptr : static_cast<shared_waiter *>(head);
+            if (head_.compare_exchange_weak(head, &waiter, std::memory_order_acq_rel, std::memory_order_acquire))
+                break;
+        }
+
+        if (nullptr == head)
+        {
+            keepAlive_ = this->shared_from_this();
+            next = runner_;
+        }
+
+        return true;
+    }
+    /// @brief Stores the result and resumes all the waiters on the Scheduler.
+    template <typename... R> void complete(R &&...result)
+    {
+        if constexpr (!std::is_void_v<T>)
+            result_.emplace(std::forward<R>(result)...);
+
+        auto head = head_.exchange(completed(), std::memory_order_acq_rel);
+        auto waiter = (started() == head) ? nullptr : static_cast<shared_waiter *>(head);
+        while (nullptr != waiter)
+        {
+            // The waiter is gone as soon as its coroutine is resumed.
+            auto next = waiter->next_;
+            Scheduler::getInstance()->spawn(waiter->handle_);
+            waiter = next;
+        }
+    }
+    /// @brief Returns the keep alive reference to the state, taken by the runner for the time of the work.
+    std::shared_ptr<shared_state> release()
+    {
+        return std::move(keepAlive_);
+    }
+    bool done() const
+    {
+        return completed() == head_.load(std::memory_order_acquire);
+    }
+    std::conditional_t<std::is_void_v<T>, std::monostate, T> const &result() const
+    {
+        if constexpr (std::is_void_v<T>)
+            return result_;
+        else
+            return *result_;
+    }
+
+  private:
+    void *started() const
+    {
+        return const_cast<std::coroutine_handle<> *>(&runner_);
+    }
+    void *completed() const
+    {
+        return const_cast<shared_state *>(this);
+    }
+
+    std::atomic<void *> head_{};
+    std::coroutine_handle<> runner_{};
+    std::shared_ptr<shared_state> keepAlive_{};
+    std::conditional_t<std::is_void_v<T>, std::monostate, std::optional<T>> result_{};
+};
+
+/// @brief The coroutine that runs the work of the shared task and completes its state.
+template <typename T, typename Task> shared_runner runShared(shared_state<T> *state, Task task)
+{
+    // Keeps the state alive until the waiters are resumed, even if none of them holds the shared task anymore.
+    auto keepAlive = state->release();
+
+    if constexpr (std::is_void_v<T>)
+    {
+        co_await task;
+        state->complete();
+    }
+    else
+        state->complete(co_await task);
+}
+
+/// @brief The class that represents the task which many coroutines may co_await concurrently. Its work runs exactly
+/// once, started by the first awaiter, and all the awaiters are resumed on the Scheduler with the copy of the result.
+/// The copies of the shared task share the same work.
+/// @tparam T The type of the result, i.e. the result of co_await on the wrapped task, e.g. std::expected<T, E>.
+template <typename T> class shared_task
+{
+  public:
+    /// @brief The class that represents an awaiter of the shared task.
+    class awaiter
+    {
+      public:
+        awaiter(std::shared_ptr<shared_state<T>> state) : state_{std::move(state)}
+        {
+        }
+        bool await_ready() noexcept
+        {
+            return state_->done();
+        }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> handle)
+        {
+            waiter_.handle_ = handle;
+
+            std::coroutine_handle<> next{};
+            if (!state_->wait(waiter_, next))
+                return handle;
+
+            // Symmetric transfer to the runner, if the work is started by this awaiter.
+            return next;
+        }
+        T await_resume()
+        {
+            if constexpr (!std::is_void_v<T>)
+                return state_->result();
+        }
+
+      private:
+        std::shared_ptr<shared_state<T>> state_{};
+        shared_waiter waiter_{};
+    };
+
+    /// @brief Makes the shared task of the async task of any flavour. The task isn't started until the first co_await.
+    template <typename Task>
+        requires(!std::is_same_v<std::remove_cvref_t<Task>, shared_task>)
+    shared_task(Task task) : state_{std::make_shared<shared_state<T>>()}
+    {
+        state_->setRunner(runShared<T>(state_.get(), std::move(task)).handle_);
+    }
+
+    awaiter operator co_await() const
+    {
+        return {state_};
+    }
+    /// @brief Starts the work on the Scheduler without waiting for it, e.g. to warm up.
+    void start()
+    {
+        if (auto runner = state_->start())
+            Scheduler::getInstance()->spawn(runner);
+    }
+    bool done() const
+    {
+        return state_->done();
+    }
+    /// @brief Returns the result, should be called only when the task is done.
+    T result() const
+    {
+        if constexpr (!std::is_void_v<T>)
+            return state_->result();
+    }
+
+  private:
+    std::shared_ptr<shared_state<T>> state_{};
+};
+
+/// @brief The deduction guide of the shared task result type from the wrapped async task of any flavour.
+template <typename Task> shared_task(Task) -> shared_task<await_result_t<Task>>;
+} // namespace coasyncpp
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef __COASYNCPP_SLICE_WATCHDOG_HPP__
+#define __COASYNCPP_SLICE_WATCHDOG_HPP__
+
+#include "scheduler.hpp"
+#include "async_stack.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The class that represents the watchdog of the run slices of the Scheduler workers. The coroutine which runs
+/// longer than the budget between its suspension points starves the coroutines queued on its worker, the watchdog
+/// reports it once per slice with the counters of the worker and optionally moves the queued coroutines to the global
+/// queue, where the other workers run them.
+class slice_watchdog
+{
+  public:
+    /// @brief Starts the watchdog thread.
+    /// @param budget The parameter that represents the longest run slice which is not reported.
+    /// @param migrate The parameter that represents whether to move the coroutines queued on the worker.
+    /// @param out The parameter that represents the stream to report to.
+    slice_watchdog(std::chrono::steady_clock::duration budget, bool migrate = false, std::ostream &out = std::cerr) :
+        budget_{budget}, migrate_{migrate}, out_{out},
+        reported_(Scheduler::getInstance()->workerCount())
+    {
+        thread_ = std::thread{[this]() { run(); }};
+    }
+    ~slice_watchdog()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            isRunning_ = false;
+        }
+        cv_.notify_one();
+        thread_.join();
+    }
+    slice_watchdog(slice_watchdog const &) = delete;
+    slice_watchdog &operator=(slice_watchdog const &) = delete;
+
+    /// @brief Returns the count of the run slices reported so far.
+    std::size_t overruns() const
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return overruns_;
+    }
+
+  private:
+    void run()
+    {
+        auto interval = std::max<std::chrono::steady_clock::duration>(budget_ / 4, std::chrono::milliseconds{1});
+
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (!cv_.wait_for(lock, interval, [this]() { return !isRunning_; }))
+        {
+            for (auto const &slice : Scheduler::getInstance()->runningSlices())
+            {
+                if (slice.elapsed_ >= budget_ && slice.since_ != reported_[slice.worker_])
+                    report(slice);
+            }
+        }
+    }
+    void report(running_slice const &slice)
+    {
+        reported_[slice.worker_] = slice.since_;
+        ++overruns_;
+
+        auto stats = Scheduler::getInstance()->stats();
+        auto const &worker = stats.workers_[slice.worker_];
+
+        // The coroutine may be complete and destroyed already, it's named by its resume function only.
+        out_ << "Worker " << slice.worker_ << " runs "
+             << (nullptr == slice.code_ ? std::string{"the scheduled task step"} : symbolizeCode(slice.code_)) << " ("
+             << slice.address_ << ") for "
+             << std::chrono::duration_cast<std::chrono::milliseconds>(slice.elapsed_).count() << "ms, over the budget of "
+             << std::chrono::duration_cast<std::chrono::milliseconds>(budget_).count() << "ms: " << worker.queueDepth_
+             << " queued, " << worker.executed_ << " executed, run slice p99 "
+             << worker.runSlices_.percentile(0.99) / 1000 << "us, global queue " << stats.globalQueueDepth_;
+        if (migrate_)
+            out_ << ", migrated " << Scheduler::getInstance()->migrate(slice.worker_);
+        out_ << std::endl;
+    }
+
+    std::chrono::steady_clock::duration budget_{};
+    bool migrate_{};
+    std::ostream &out_;
+    mutable std::mutex mutex_{};
+    std::condition_variable cv_{};
+    bool isRunning_{true};
+    // The start of the slice reported last per worker.
+    std::vector<std::int64_t> reported_{};
+    std::size_t overruns_{};
+    std::thread thread_{};
+};
+} // namespace coasyncpp
+
+#endif
@@ -0,0 +1,239 @@
+#ifndef __COASYNCPP_STATS_HPP__
+#define __COASYNCPP_STATS_HPP__
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The class that represents the HDR-style histogram of the durations in nanoseconds: every power of two range
+/// is split into 16 linear buckets, so the relative error is at most 1/16. It's written by a single thread with
+/// relaxed atomics, any thread may take the snapshot.
+class duration_histogram
+{
+  public:
+    static constexpr std::size_t subBucketBits{4};
+    static constexpr std::size_t subBuckets{1 << subBucketBits};
+    static constexpr std::size_t bucketCount{(64 - subBucketBits + 1) * subBuckets};
+
+    /// @brief The class that represents the copy of the histogram counts.
+    class snapshot
+    {
+      public:
+        snapshot() : counts_(bucketCount)
+        {
+        }
+
+        std::uint64_t count() const
+        {
+            return count_;
+        }
+        std::uint64_t max() const
+        {
+            return max_;
+        }
+        /// @brief Returns the upper bound of the bucket of the given percentile, e.g. 0.99, in nanoseconds.
+        std::uint64_t percentile(double percentile) const
+        {
+            if (0 == count_)
+                return 0;
+
+            auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(percentile * count_ + 0.5));
+            std::uint64_t seen{};
+            for (std::size_t bucket = 0; bucket < bucketCount; ++bucket)
+            {
+                seen += counts_[bucket];
+                if (seen >= rank)
+                    return std::min(max_, upperBound(bucket));
+            }
+
+            return max_;
+        }
+        /// @brief Adds the counts of the other histogram, e.g. to aggregate the workers.
+        snapshot &operator+=(snapshot const &other)
+        {
+            for (std::size_t bucket = 0; bucket < bucketCount; ++bucket)
+                counts_[bucket] += other.counts_[bucket];
+            count_ += other.count_;
+            max_ = std::max(max_, other.max_);
+
+            return *this;
+        }
+
+      private:
+        friend class duration_histogram;
+
+        std::vector<std::uint64_t> counts_;
+        std::uint64_t count_{};
+        std::uint64_t max_{};
+    };
+
+    /// @brief Records the duration. Called by the single writer thread only.
+    void record(std::chrono::nanoseconds duration)
+    {
+        auto value = static_cast<std::uint64_t>(std::max<std::int64_t>(0, duration.count()));
+        auto &count = counts_[bucketOf(value)];
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (value > max_.load(std::memory_order_relaxed))
+            max_.store(value, std::memory_order_relaxed);
+    }
+    snapshot take() const
+    {
+        snapshot taken{};
+        for (std::size_t bucket = 0; bucket < bucketCount; ++bucket)
+        {
+            taken.counts_[bucket] = counts_[bucket].load(std::memory_order_relaxed);
+            taken.count_ += taken.counts_[bucket];
+        }
+        taken.max_ = max_.load(std::memory_order_relaxed);
+
+        return taken;
+    }
+
+    static std::size_t bucketOf(std::uint64_t value)
+    {
+        if (value < subBuckets)
+            return value;
+
+        auto exponent = static_cast<std::size_t>(std::bit_width(value)) - 1;
+        auto subBucket = (value >> (exponent - subBucketBits)) & (subBuckets - 1);
+
+        return (exponent - subBucketBits + 1) * subBuckets + subBucket;
+    }
+    static std::uint64_t upperBound(std::size_t bucket)
+    {
+        if (bucket < subBuckets)
+            return bucket;
+
+        auto exponent = bucket / subBuckets + subBucketBits - 1;
+        auto lowerBound = (subBuckets + bucket % subBuckets) << (exponent - subBucketBits);
+
+        return lowerBound + (std::uint64_t{1} << (exponent - subBucketBits)) - 1;
+    }
+
+  private:
+    std::array<std::atomic<std::uint64_t>, bucketCount> counts_{};
+    std::atomic<std::uint64_t> max_{};
+};
+
+/// @brief The struct that represents the counters of the Scheduler worker, written by the worker only.
+struct alignas(64) worker_counters
+{
+    // The coroutines pushed to the local deque and the tasks pushed to the global queue from the worker.
+    std::atomic<std::uint64_t> scheduled_{};
+    // The coroutines resumed and the task steps executed.
+    std::atomic<std::uint64_t> executed_{};
+    std::atomic<std::uint64_t> steals_{};
+    // The passes of the worker loop which found no work and yielded the thread.
+    std::atomic<std::uint64_t> idle_{};
+    // The time from pushing to the global queue, or from the timer deadline, to running.
+    duration_histogram queueLatency_{};
+    // The time of every run of the coroutine or the task step.
+    duration_histogram runSlices_{};
+
+    /// @brief Increments the counter without the atomic read-modify-write, since the worker is the only writer.
+    static void increment(std::atomic<std::uint64_t> &counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+/// @brief The struct that represents the snapshot of the worker counters.
+struct worker_stats
+{
+    std::size_t index_{};
+    std::uint64_t scheduled_{};
+    std::uint64_t executed_{};
+    std::uint64_t steals_{};
+    std::uint64_t idle_{};
+    std::size_t queueDepth_{};
+    duration_histogram::snapshot queueLatency_{};
+    duration_histogram::snapshot runSlices_{};
+    // The shard of the global queue the worker runs first and its CPU.
+    std::size_t shard_{};
+    int cpu_{};
+};
+
+/// @brief The struct that represents the run slice in progress on the worker.
+struct running_slice
+{
+    std::size_t worker_{};
+    // The resumed coroutine and its resume function, null for the step of the scheduled task.
+    void *address_{};
+    void *code_{};
+    // The start of the slice in the ticks of the steady clock, identifies the slice of the worker.
+    std::int64_t since_{};
+    std::chrono::steady_clock::duration elapsed_{};
+};
+
+/// @brief The struct that represents the snapshot of the admission control counters.
+struct admission_stats
+{
+    std::uint64_t admitted_{};
+    std::uint64_t rejected_{};
+    std::uint64_t shed_{};
+    // The submitted tasks queued and not started yet.
+    std::size_t queued_{};
+    bool isOverloaded_{};
+};
+
+/// @brief The struct that represents the snapshot of the Scheduler counters.
+struct scheduler_stats
+{
+    std::vector<worker_stats> workers_{};
+    // Scheduled from outside the workers.
+    std::uint64_t externalScheduled_{};
+    std::size_t globalQueueDepth_{};
+    std::size_t timers_{};
+    admission_stats admission_{};
+
+    /// @brief Writes the counters in the Prometheus text format.
+    void dump(std::ostream &out) const
+    {
+        out << "coasyncpp_global_queue_depth " << globalQueueDepth_ << "\n";
+        out << "coasyncpp_timers " << timers_ << "\n";
+        out << "coasyncpp_external_scheduled_total " << externalScheduled_ << "\n";
+        out << "coasyncpp_admitted_total " << admission_.admitted_ << "\n";
+        out << "coasyncpp_rejected_total " << admission_.rejected_ << "\n";
+        out << "coasyncpp_shed_total " << admission_.shed_ << "\n";
+        out << "coasyncpp_admitted_queued " << admission_.queued_ << "\n";
+        out << "coasyncpp_overloaded " << admission_.isOverloaded_ << "\n";
+
+        for (auto const &worker : workers_)
+        {
+            auto label = "{worker=\"" + std::to_string(worker.index_) + "\"}";
+            out << "coasyncpp_worker_scheduled_total" << label << " " << worker.scheduled_ << "\n";
+            out << "coasyncpp_worker_executed_total" << label << " " << worker.executed_ << "\n";
+            out << "coasyncpp_worker_steals_total" << label << " " << worker.steals_ << "\n";
+            out << "coasyncpp_worker_idle_total" << label << " " << worker.idle_ << "\n";
+            out << "coasyncpp_worker_queue_depth" << label << " " << worker.queueDepth_ << "\n";
+            dumpHistogram(out, "coasyncpp_worker_queue_latency_seconds", worker.index_, worker.queueLatency_);
+            dumpHistogram(out, "coasyncpp_worker_run_slice_seconds", worker.index_, worker.runSlices_);
+        }
+    }
+
+  private:
+    static void dumpHistogram(std::ostream &out, char const *name, std::size_t worker,
+        duration_histogram::snapshot const &histogram)
+    {
+        for (auto quantile : {0.5, 0.9, 0.99, 0.999})
+        {
+            out << name << "{worker=\"" << worker << "\",quantile=\"" << quantile << "\"} "
+                << histogram.percentile(quantile) / 1e9 << "\n";
+        }
+        out << name << "_max{worker=\"" << worker << "\"} " << histogram.max() / 1e9 << "\n";
+        out << name << "_count{worker=\"" << worker << "\"} " << histogram.count() << "\n";
+    }
+};
+} // namespace coasyncpp
+
+#endif
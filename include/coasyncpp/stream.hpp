@@ -0,0 +1,466 @@
+#ifndef __COASYNCPP_STREAM_HPP__
+#define __COASYNCPP_STREAM_HPP__
+
+#include "common.hpp"
+#include "scheduler.hpp"
+#include "ring_buffer.hpp"
+#include "prefetch.hpp"
+#include "async_generator.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The constant that represents default count of values buffered per stream source.
+inline constexpr std::size_t defaultStreamCapacity{16};
+
+/// @brief The class that represents an auto-reset signal which wakes up the single waiting coroutine on the Scheduler.
+/// The wake up may be spurious, so the waiter should check its condition in a loop.
+class async_signal
+{
+  public:
+    /// @brief The class that represents an awaiter which suspends until the signal is notified.
+    /// @tparam Ready The type of the predicate which tells there is no need to wait at all.
+    template <typename Ready> class awaiter
+    {
+      public:
+        awaiter(async_signal &signal, Ready ready) : signal_{signal}, ready_{std::move(ready)}
+        {
+        }
+        bool await_ready()
+        {
+            return ready_();
+        }
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            // The condition can't be checked here anymore, since the coroutine may be resumed concurrently.
+            auto state = signal_.state_.load();
+            while (true)
+            {
+                if (notified == state)
+                {
+                    if (signal_.state_.compare_exchange_weak(state, idle))
+                        return false;
+                }
+                else if (signal_.state_.compare_exchange_weak(state, reinterpret_cast<std::uintptr_t>(handle.address())))
+                    return true;
+            }
+        }
+        void await_resume()
+        {
+        }
+
+      private:
+        async_signal &signal_;
+        Ready ready_;
+    };
+
+    template <typename Ready> awaiter<Ready> wait(Ready ready)
+    {
+        return {*this, std::move(ready)};
+    }
+    void notify()
+    {
+        auto state = state_.load();
+        while (notified != state)
+        {
+            if (idle == state)
+            {
+                if (state_.compare_exchange_weak(state, notified))
+                    return;
+            }
+            else if (state_.compare_exchange_weak(state, idle))
+            {
+                Scheduler::getInstance()->schedule(std::coroutine_handle<>::from_address(reinterpret_cast<void *>(state)));
+                return;
+            }
+        }
+    }
+
+  private:
+    static constexpr std::uintptr_t idle{0};
+    static constexpr std::uintptr_t notified{1};
+
+    // Either idle, or notified, or the address of the waiting coroutine.
+    std::atomic<std::uintptr_t> state_{idle};
+};
+
+/// @brief The class that represents bounded buffer between the stream source running on the Scheduler and the
+/// stream combinator consuming it.
+/// @tparam T The type of the stream values.
+template <typename T> class stream_channel
+{
+  public:
+    stream_channel(std::size_t capacity, std::shared_ptr<async_signal> consumer) :
+        buffer_{capacity}, consumer_{std::move(consumer)}
+    {
+    }
+
+    // Producer side
+    template <typename U> bool tryPush(U &&value)
+    {
+        if (!buffer_.tryPush(std::forward<U>(value)))
+            return false;
+
+        consumer_->notify();
+        return true;
+    }
+    bool full() const
+    {
+        return buffer_.full();
+    }
+    void finish(std::exception_ptr exception = nullptr)
+    {
+        exception_ = exception;
+        finished_.store(true, std::memory_order_release);
+        consumer_->notify();
+    }
+    bool cancelled() const
+    {
+        return cancelled_.load(std::memory_order_acquire);
+    }
+    async_signal &producer()
+    {
+        return producer_;
+    }
+
+    // Consumer side
+    bool tryPop(T &value)
+    {
+        if (!buffer_.tryPop(value))
+            return false;
+
+        producer_.notify();
+        return true;
+    }
+    /// @brief Checks there is a value to pop or the source is finished.
+    bool ready() const
+    {
+        return finished_.load(std::memory_order_acquire) || !buffer_.empty();
+    }
+    /// @brief Checks the source is finished and all its values are consumed. Rethrows the source exception if any.
+    bool exhausted() const
+    {
+        if (!finished_.load(std::memory_order_acquire) || !buffer_.empty())
+            return false;
+
+        if (exception_)
+            std::rethrow_exception(exception_);
+
+        return true;
+    }
+    void cancel()
+    {
+        cancelled_.store(true, std::memory_order_release);
+        producer_.notify();
+    }
+
+  private:
+    spsc_ring_buffer<T> buffer_;
+    std::shared_ptr<async_signal> consumer_{};
+    async_signal producer_{};
+    std::exception_ptr exception_{};
+    std::atomic<bool> finished_{};
+    std::atomic<bool> cancelled_{};
+};
+
+/// @brief The class that represents the stream source of the async<T> generator of any flavour. It is executed by
+/// the Scheduler worker while there is a space in the channel.
+/// @tparam Task The type of the async generator.
+template <typename Task> class stream_task : public async_interface
+{
+  public:
+    using value_type = generator_value_t<Task>;
+
+    stream_task(Task task, std::shared_ptr<stream_channel<value_type>> channel) :
+        task_{std::move(task)}, channel_{std::move(channel)}
+    {
+    }
+
+    void execute() override
+    {
+        if (channel_->cancelled())
+            return;
+
+        // The source awaiting anything else, e.g. the timer, is resumed by what it awaits, the step is given up until
+        // it yields.
+        while (!task_.done() && task_.atStep())
+        {
+            if (started_)
+            {
+                if (channel_->full())
+                    return;
+
+                channel_->tryPush(task_.result());
+            }
+            started_ = true;
+            task_.execute();
+        }
+
+        if (!task_.done())
+            return;
+
+        finished_ = true;
+        channel_->finish();
+    }
+    bool done() override
+    {
+        return finished_ || channel_->cancelled();
+    }
+    async_frame *taskFrame() override
+    {
+        // The source resumed by the Scheduler is queued along with the stream task, which is not stepped meanwhile.
+        return &task_.stackFrame();
+    }
+
+  private:
+    Task task_;
+    std::shared_ptr<stream_channel<value_type>> channel_{};
+    bool started_{};
+    bool finished_{};
+};
+
+/// @brief The type trait that represents value type of the stream source.
+template <typename S> struct stream_traits
+{
+    using value_type = generator_value_t<S>;
+};
+template <typename T> struct stream_traits<async_generator<T>>
+{
+    using value_type = T;
+};
+template <typename S> using stream_value_t = typename stream_traits<S>::value_type;
+
+/// @brief The coroutine that pumps the async generator into the channel on the Scheduler.
+template <typename T> detached_task pumpStream(async_generator<T> gen, std::shared_ptr<stream_channel<T>> channel)
+{
+    try
+    {
+        while (!channel->cancelled())
+        {
+            auto value = co_await gen.next();
+            if (!value)
+                break;
+
+            auto hasSpace = [&channel]() { return !channel->full() || channel->cancelled(); };
+            while (!hasSpace())
+                co_await channel->producer().wait(hasSpace);
+
+            channel->tryPush(std::move(*value));
+        }
+        channel->finish();
+    }
+    catch (...)
+    {
+        channel->finish(std::current_exception());
+    }
+}
+
+/// @brief Starts the async generator as the stream source running concurrently on the Scheduler.
+template <typename T>
+std::shared_ptr<stream_channel<T>> openStream(
+    async_generator<T> gen, std::shared_ptr<async_signal> consumer, std::size_t capacity)
+{
+    auto channel = std::make_shared<stream_channel<T>>(capacity, std::move(consumer));
+    pumpStream(std::move(gen), channel);
+
+    return channel;
+}
+/// @brief Starts the async<T> generator as the stream source running concurrently on the Scheduler.
+template <typename Task>
+std::shared_ptr<stream_channel<stream_value_t<Task>>> openStream(
+    Task task, std::shared_ptr<async_signal> consumer, std::size_t capacity)
+{
+    auto channel = std::make_shared<stream_channel<stream_value_t<Task>>>(capacity, std::move(consumer));
+    Scheduler::getInstance()->schedule(std::make_shared<stream_task<Task>>(std::move(task), channel));
+
+    return channel;
+}
+
+/// @brief The class that represents the set of stream channels opened by a combinator. It cancels the sources which
+/// are still running when the combinator is destroyed.
+/// @tparam T The type of the stream values.
+template <typename T> class stream_channels
+{
+  public:
+    stream_channels(std::shared_ptr<async_signal> signal) : signal_{std::move(signal)}
+    {
+    }
+    stream_channels(stream_channels &&) = default;
+    ~stream_channels()
+    {
+        for (auto &channel : channels_)
+            channel->cancel();
+    }
+
+    template <typename S> void open(S source, std::size_t capacity)
+    {
+        channels_.push_back(openStream(std::move(source), signal_, capacity));
+    }
+
+    /// @brief Waits until the channel has a value or is finished.
+    auto wait(stream_channel<T> &channel)
+    {
+        return signal_->wait([&channel]() { return channel.ready(); });
+    }
+    /// @brief Waits until any of the channels has a value or is finished.
+    auto waitAny()
+    {
+        return signal_->wait([this]() {
+            for (auto &channel : channels_)
+                if (channel->ready())
+                    return true;
+            return false;
+        });
+    }
+
+    std::shared_ptr<async_signal> signal_{};
+    std::vector<std::shared_ptr<stream_channel<T>>> channels_{};
+};
+
+template <typename S> stream_channels<stream_value_t<S>> openStreams(std::vector<S> sources, std::size_t capacity)
+{
+    stream_channels<stream_value_t<S>> channels{std::make_shared<async_signal>()};
+    for (auto &source : sources)
+        channels.open(std::move(source), capacity);
+
+    return channels;
+}
+
+/// @brief The coroutine that emits values of all the sources in the order they are produced.
+/// @param sources The parameter that represents the async generators to merge. All of them run concurrently.
+/// @param capacity The parameter that represents the maximal count of values buffered per source.
+template <typename S>
+async_generator<stream_value_t<S>> merge(std::vector<S> sources, std::size_t capacity = defaultStreamCapacity)
+{
+    auto streams = openStreams(std::move(sources), capacity);
+    auto &channels = streams.channels_;
+
+    // Start polling from the next channel every round to not starve the last ones.
+    for (std::size_t first = 0; !channels.empty(); ++first)
+    {
+        bool popped{};
+        for (std::size_t i = 0; i < channels.size();)
+        {
+            auto &channel = *channels[(first + i) % channels.size()];
+
+            stream_value_t<S> value{};
+            if (channel.tryPop(value))
+            {
+                popped = true;
+                co_yield std::move(value);
+                ++i;
+            }
+            else if (channel.exhausted())
+                channels.erase(channels.begin() + (first + i) % channels.size());
+            else
+                ++i;
+        }
+
+        if (!popped && !channels.empty())
+            co_await streams.waitAny();
+    }
+}
+
+/// @brief The coroutine that emits all the values of the first source, then of the second one and so on. All the
+/// sources run concurrently, so the next source is already buffered when the previous one is over.
+/// @param sources The parameter that represents the async generators to concatenate.
+/// @param capacity The parameter that represents the maximal count of values buffered per source.
+template <typename S>
+async_generator<stream_value_t<S>> concat(std::vector<S> sources, std::size_t capacity = defaultStreamCapacity)
+{
+    auto streams = openStreams(std::move(sources), capacity);
+
+    for (auto &channel : streams.channels_)
+    {
+        while (true)
+        {
+            co_await streams.wait(*channel);
+
+            stream_value_t<S> value{};
+            if (channel->tryPop(value))
+                co_yield std::move(value);
+            else if (channel->exhausted())
+                break;
+        }
+    }
+}
+
+/// @brief The coroutine that emits one value of every source in turn. Exhausted sources are skipped.
+/// @param sources The parameter that represents the async generators to interleave. All of them run concurrently.
+/// @param capacity The parameter that represents the maximal count of values buffered per source.
+template <typename S>
+async_generator<stream_value_t<S>> interleave(std::vector<S> sources, std::size_t capacity = defaultStreamCapacity)
+{
+    auto streams = openStreams(std::move(sources), capacity);
+    auto &channels = streams.channels_;
+
+    for (std::size_t i = 0; !channels.empty();)
+    {
+        auto &channel = *channels[i];
+        co_await streams.wait(channel);
+
+        stream_value_t<S> value{};
+        if (channel.tryPop(value))
+        {
+            co_yield std::move(value);
+            i = (i + 1) % channels.size();
+        }
+        else if (channel.exhausted())
+        {
+            channels.erase(channels.begin() + i);
+            if (i == channels.size())
+                i = 0;
+        }
+    }
+}
+
+/// @brief The coroutine that emits tuples of the values with the same index from every source. It's over when any of
+/// the sources is over.
+/// @param sources The parameter that represents the async generators to zip. All of them run concurrently.
+template <typename... Ss> async_generator<std::tuple<stream_value_t<Ss>...>> zip(Ss... sources)
+{
+    auto signal = std::make_shared<async_signal>();
+    std::tuple channels{openStream(std::move(sources), signal, defaultStreamCapacity)...};
+
+    struct cancel_guard
+    {
+        ~cancel_guard()
+        {
+            std::apply([](auto &...channel) { (channel->cancel(), ...); }, channels_);
+        }
+        decltype(channels) &channels_;
+    } guard{channels};
+
+    auto ready = [&channels]() { return std::apply([](auto &...channel) { return (channel->ready() && ...); }, channels); };
+
+    while (true)
+    {
+        while (!ready())
+            co_await signal->wait(ready);
+
+        if (std::apply([](auto &...channel) { return (channel->exhausted() || ...); }, channels))
+            co_return;
+
+        std::tuple<stream_value_t<Ss>...> values{};
+        std::apply(
+            [&values](auto &...channel) {
+                std::apply([&channel...](auto &...value) { (channel->tryPop(value), ...); }, values);
+            },
+            channels);
+
+        co_yield std::move(values);
+    }
+}
+} // namespace coasyncpp
+
+#endif
@@ -0,0 +1,370 @@
+#ifndef __COASYNCPP_TASK_GRAPH_HPP__
+#define __COASYNCPP_TASK_GRAPH_HPP__
+
+#include "common.hpp"
+#include "scheduler.hpp"
+#include "async_core.hpp"
+#include "latch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The class that represents the node of the task graph: the count of its incomplete dependencies, the nodes
+/// depending on it and its rank, i.e. the cost of the longest path from it to the end of the graph.
+class graph_node_base
+{
+  public:
+    virtual ~graph_node_base() = default;
+
+    /// @brief Runs the task of the node with the results of its dependencies.
+    virtual core::async<void> run() = 0;
+
+    std::atomic<std::size_t> pending_{};
+    std::vector<graph_node_base *> successors_{};
+    std::size_t cost_{1};
+    std::size_t rank_{};
+};
+
+/// @brief The trait that represents the reference to the result of the node and the arguments it passes along the
+/// edge, none for void.
+template <typename T> struct graph_result_traits
+{
+    using reference = T const &;
+    using arguments = std::tuple<T const &>;
+};
+template <> struct graph_result_traits<void>
+{
+    using reference = void;
+    using arguments = std::tuple<>;
+};
+
+template <typename T> using graph_reference_t = typename graph_result_traits<T>::reference;
+
+/// @brief The class that represents the node of the task graph with the result.
+/// @tparam T The type of the result, i.e. the result of co_await on the task of any flavour.
+template <typename T> class graph_node_value : public graph_node_base
+{
+  public:
+    graph_reference_t<T> value() const
+    {
+        if constexpr (!std::is_void_v<T>)
+            return *result_;
+    }
+
+  protected:
+    std::conditional_t<std::is_void_v<T>, std::monostate, std::optional<T>> result_{};
+};
+
+template <typename T> using graph_arguments_t = typename graph_result_traits<T>::arguments;
+
+template <typename T> graph_arguments_t<T> graphArguments(graph_node_value<T> *node)
+{
+    if constexpr (std::is_void_v<T>)
+        return {};
+    else
+        return {node->value()};
+}
+
+/// @brief The type that represents the arguments of the node task, the results of all the dependencies.
+template <typename... Ds>
+using graph_all_arguments_t = decltype(std::tuple_cat(std::declval<graph_arguments_t<Ds>>()...));
+
+/// @brief The type that represents the result of the node task called with the results of the dependencies.
+template <typename F, typename... Ds>
+using graph_result_t =
+    await_result_t<decltype(std::apply(std::declval<F &>(), std::declval<graph_all_arguments_t<Ds...>>()))>;
+
+/// @brief The class that represents the node of the task graph calling the function with the dependency results.
+/// @tparam F The type of the function which returns the async task of any flavour.
+/// @tparam Ds The types of the dependency results.
+template <typename F, typename... Ds> class graph_task_node : public graph_node_value<graph_result_t<F, Ds...>>
+{
+  public:
+    using result_type = graph_result_t<F, Ds...>;
+
+    graph_task_node(F func, graph_node_value<Ds> *...dependencies) : func_{std::move(func)}, dependencies_{dependencies...}
+    {
+    }
+
+    core::async<void> run() override
+    {
+        auto task = std::apply(
+            [this](auto *...dependencies) {
+                return std::apply(func_, std::tuple_cat(graphArguments(dependencies)...));
+            },
+            dependencies_);
+
+        if constexpr (std::is_void_v<result_type>)
+            co_await task;
+        else
+            this->result_.emplace(co_await task);
+    }
+
+  private:
+    F func_;
+    std::tuple<graph_node_value<Ds> *...> dependencies_;
+};
+
+/// @brief The class that represents the handle of the task graph node, to declare the dependencies on it and to get its
+/// result once the graph is complete.
+/// @tparam T The type of the node result.
+template <typename T> class graph_node
+{
+  public:
+    graph_node(graph_node_value<T> *node) : node_{node}
+    {
+    }
+
+    /// @brief Returns the result, should be called only when the graph is complete.
+    graph_reference_t<T> result() const
+    {
+        return node_->value();
+    }
+    /// @brief Sets the relative cost of the node, 1 by default, used to find the critical path.
+    graph_node &cost(std::size_t cost)
+    {
+        node_->cost_ = cost;
+        return *this;
+    }
+    graph_node_value<T> *get() const
+    {
+        return node_;
+    }
+
+  private:
+    graph_node_value<T> *node_{};
+};
+
+/// @brief The class that represents the graph of the async tasks with the explicit dependencies. Every node is run as
+/// soon as its dependencies are complete, with their results passed along the edges. Among the ready nodes the ones on
+/// the longest remaining path are run first.
+class task_graph
+{
+  public:
+    task_graph() = default;
+    task_graph(task_graph const &) = delete;
+    task_graph &operator=(task_graph const &) = delete;
+
+    /// @brief Adds the node calling the function with the results of the dependencies, void ones are skipped.
+    /// @param func The parameter that represents the function which returns the async task of any flavour.
+    /// @param dependencies The parameter that represents the nodes of the same graph the node depends on.
+    /// @return Returns the handle of the node.
+    template <typename F, typename... Ds> auto add(F func, graph_node<Ds>... dependencies)
+    {
+        auto node = std::make_unique<graph_task_node<F, Ds...>>(std::move(func), dependencies.get()...);
+        node->pending_ = sizeof...(Ds);
+        (dependencies.get()->successors_.push_back(node.get()), ...);
+
+        graph_node<typename graph_task_node<F, Ds...>::result_type> handle{node.get()};
+        nodes_.push_back(std::move(node));
+
+        return handle;
+    }
+
+    /// @brief Adds the dependency which passes no result, e.g. when the count of the dependencies is known at runtime
+    /// only. The node may read the result of the dependency through its handle.
+    template <typename T, typename D> void addDependency(graph_node<T> node, graph_node<D> dependency)
+    {
+        node.get()->pending_.fetch_add(1, std::memory_order_relaxed);
+        dependency.get()->successors_.push_back(node.get());
+    }
+
+    /// @brief The coroutine that runs the graph. The graph should be run once and outlive the run.
+    /// @param maxInFlight The parameter that represents the maximal count of the nodes running at once, the count of
+    /// the Scheduler workers by default.
+    core::async<void> run(std::size_t maxInFlight = 0)
+    {
+        if (nodes_.empty())
+            co_return;
+
+        rank();
+
+        for (auto &node : nodes_)
+        {
+            if (0 == node->pending_)
+                ready_.push(node.get());
+        }
+
+        if (0 == maxInFlight)
+            maxInFlight = Scheduler::getInstance()->workerCount();
+        auto lanes = std::min(maxInFlight, nodes_.size());
+
+        remaining_ = nodes_.size();
+        latch_ = std::make_unique<async_latch>(lanes);
+        for (std::size_t i = 0; i < lanes; ++i)
+            runLane();
+
+        co_await latch_->wait();
+    }
+
+  private:
+    /// @brief The struct that represents the order of the ready nodes, the highest rank first.
+    struct rank_less
+    {
+        bool operator()(graph_node_base *lh, graph_node_base *rh) const
+        {
+            return lh->rank_ < rh->rank_;
+        }
+    };
+
+    /// @brief The class that represents an awaiter which takes the ready node or parks the lane until there is one.
+    class ready_awaiter
+    {
+      public:
+        ready_awaiter(task_graph &graph) : graph_{graph}
+        {
+        }
+        bool await_ready() noexcept
+        {
+            return false;
+        }
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            std::lock_guard<std::mutex> lock{graph_.mutex_};
+            if (!graph_.ready_.empty())
+            {
+                node_ = graph_.ready_.top();
+                graph_.ready_.pop();
+                return false;
+            }
+            if (0 == graph_.remaining_.load(std::memory_order_acquire))
+                return false;
+
+            handle_ = handle;
+            graph_.idle_.push_back(this);
+            return true;
+        }
+        graph_node_base *await_resume() noexcept
+        {
+            return node_;
+        }
+
+      private:
+        friend class task_graph;
+
+        task_graph &graph_;
+        std::coroutine_handle<> handle_{};
+        graph_node_base *node_{};
+    };
+
+    /// @brief Ranks the nodes by the cost of the longest path to the end, visiting the successors first.
+    void rank()
+    {
+        // The topological order of the nodes.
+        std::vector<graph_node_base *> order{};
+        std::vector<std::size_t> pending(nodes_.size());
+        std::unordered_map<graph_node_base *, std::size_t> indices{};
+        for (std::size_t i = 0; i < nodes_.size(); ++i)
+        {
+            indices.emplace(nodes_[i].get(), i);
+            pending[i] = nodes_[i]->pending_;
+            if (0 == pending[i])
+                order.push_back(nodes_[i].get());
+        }
+        for (std::size_t i = 0; i < order.size(); ++i)
+        {
+            for (auto successor : order[i]->successors_)
+            {
+                if (0 == --pending[indices[successor]])
+                    order.push_back(successor);
+            }
+        }
+        assert(order.size() == nodes_.size() && "The task graph has a cycle.");
+
+        for (auto node = order.rbegin(); node != order.rend(); ++node)
+        {
+            std::size_t successorsRank{};
+            for (auto successor : (*node)->successors_)
+                successorsRank = std::max(successorsRank, successor->rank_);
+
+            (*node)->rank_ = (*node)->cost_ + successorsRank;
+        }
+    }
+
+    /// @brief The coroutine that runs the ready nodes one by one until the graph is complete.
+    detached_task runLane()
+    {
+        while (true)
+        {
+            auto node = co_await ready_awaiter{*this};
+            if (nullptr == node)
+                break;
+
+            co_await node->run();
+            complete(node);
+        }
+
+        latch_->countDown();
+    }
+
+    /// @brief Counts down the successors of the complete node, hands the ready ones over to the parked lanes first.
+    void complete(graph_node_base *node)
+    {
+        std::vector<graph_node_base *> ready{};
+        for (auto successor : node->successors_)
+        {
+            if (successor->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                ready.push_back(successor);
+        }
+
+        auto isLast = remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        if (ready.empty() && !isLast)
+            return;
+
+        std::sort(ready.begin(), ready.end(), [](auto lh, auto rh) { return lh->rank_ > rh->rank_; });
+
+        std::vector<ready_awaiter *> woken{};
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            for (auto successor : ready)
+            {
+                if (idle_.empty())
+                {
+                    ready_.push(successor);
+                    continue;
+                }
+
+                idle_.back()->node_ = successor;
+                woken.push_back(idle_.back());
+                idle_.pop_back();
+            }
+
+            // The graph is complete, the parked lanes are over.
+            if (isLast)
+            {
+                woken.insert(woken.end(), idle_.begin(), idle_.end());
+                idle_.clear();
+            }
+        }
+
+        for (auto awaiter : woken)
+            Scheduler::getInstance()->spawn(awaiter->handle_);
+    }
+
+    std::vector<std::unique_ptr<graph_node_base>> nodes_{};
+    std::mutex mutex_{};
+    std::priority_queue<graph_node_base *, std::vector<graph_node_base *>, rank_less> ready_{};
+    std::vector<ready_awaiter *> idle_{};
+    std::atomic<std::size_t> remaining_{};
+    std::unique_ptr<async_latch> latch_{};
+};
+} // namespace coasyncpp
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef __COASYNCPP_TOPOLOGY_HPP__
+#define __COASYNCPP_TOPOLOGY_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<pthread.h>) && __has_include(<sched.h>)
+#include <pthread.h>
+#include <sched.h>
+#define COASYNCPP_HAS_AFFINITY
+#endif
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The struct that represents the NUMA nodes with the CPUs the process may run on, the single node if the
+/// topology is unknown.
+struct cpu_topology
+{
+    // The CPUs of every node with any of them.
+    std::vector<std::vector<int>> nodes_{};
+};
+
+/// @brief Parses the list of the Linux sysfs, e.g. 0-3,8-11.
+inline std::vector<int> parseCpuList(std::string const &list)
+{
+    std::vector<int> cpus{};
+    std::istringstream in{list};
+    std::string range{};
+    while (std::getline(in, range, ','))
+    {
+        auto dash = range.find('-');
+        try
+        {
+            auto first = std::stoi(range.substr(0, dash));
+            auto last = std::string::npos == dash ? first : std::stoi(range.substr(dash + 1));
+            for (auto cpu = first; cpu <= last; ++cpu)
+                cpus.push_back(cpu);
+        }
+        catch (std::exception const &)
+        {
+        }
+    }
+
+    return cpus;
+}
+
+/// @brief Returns the CPUs the process may run on.
+inline std::vector<int> allowedCpus()
+{
+    std::vector<int> cpus{};
+#ifdef COASYNCPP_HAS_AFFINITY
+    cpu_set_t set{};
+    if (0 == sched_getaffinity(0, sizeof(set), &set))
+    {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &set))
+                cpus.push_back(cpu);
+        }
+    }
+#endif
+    if (cpus.empty())
+    {
+        for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu)
+            cpus.push_back(static_cast<int>(cpu));
+    }
+
+    return cpus;
+}
+
+/// @brief Detects the NUMA nodes from the Linux sysfs, the allowed CPUs out of any node are added to the first one.
+/// @param root The parameter that represents the directory of the nodes.
+inline cpu_topology detectTopology(std::string const &root = "/sys/devices/system/node")
+{
+    auto allowed = allowedCpus();
+
+    cpu_topology topology{};
+    std::ifstream online{root + "/online"};
+    std::string nodes{};
+    std::getline(online, nodes);
+    // The list of the nodes has the same format as the one of the CPUs.
+    for (auto node : parseCpuList(nodes))
+    {
+        std::ifstream file{root + "/node" + std::to_string(node) + "/cpulist"};
+        std::string list{};
+        std::getline(file, list);
+
+        std::vector<int> cpus{};
+        for (auto cpu : parseCpuList(list))
+        {
+            if (allowed.end() != std::find(allowed.begin(), allowed.end(), cpu))
+                cpus.push_back(cpu);
+        }
+        if (!cpus.empty())
+            topology.nodes_.push_back(std::move(cpus));
+    }
+
+    if (topology.nodes_.empty())
+        topology.nodes_.emplace_back();
+    for (auto cpu : allowed)
+    {
+        auto isKnown = std::any_of(topology.nodes_.begin(), topology.nodes_.end(),
+            [cpu](auto const &cpus) { return cpus.end() != std::find(cpus.begin(), cpus.end(), cpu); });
+        if (!isKnown)
+            topology.nodes_.front().push_back(cpu);
+    }
+
+    return topology;
+}
+
+/// @brief Pins the current thread to the CPU, it's ignored where the affinity is not supported.
+/// @return Returns true if the thread is pinned.
+inline bool pinCurrentThread(int cpu)
+{
+#ifdef COASYNCPP_HAS_AFFINITY
+    cpu_set_t set{};
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return 0 == pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    return false;
+#endif
+}
+} // namespace coasyncpp
+
+#endif
@@ -0,0 +1,272 @@
+#ifndef __COASYNCPP_TRACING_HPP__
+#define __COASYNCPP_TRACING_HPP__
+
+#include <coroutine>
+
+// The tracing hooks record the coroutine events only when COASYNCPP_TRACING is defined, otherwise they are empty.
+#ifdef COASYNCPP_TRACING
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The namespace that represents the coroutine tracing.
+namespace trace
+{
+/// @brief The enum that represents the traced event of the coroutine.
+enum class event_type : std::uint8_t
+{
+    create,
+    first_resume,
+    suspend,
+    resume,
+    complete,
+    destroy,
+    // The worker starts and ends running the coroutine.
+    slice_begin,
+    slice_end
+};
+
+inline char const *eventName(event_type type)
+{
+    static char const *names[]{"create", "first_resume", "suspend", "resume", "complete", "destroy", "run", "run"};
+    return names[static_cast<std::size_t>(type)];
+}
+
+/// @brief The struct that represents the traced event.
+struct event
+{
+    std::int64_t timestamp_{};
+    void const *address_{};
+    event_type type_{};
+};
+
+/// @brief The class that represents the lock-free ring of the events of a single thread. The owner thread writes the
+/// events, overwriting the oldest ones once the ring is full, the flush reads them.
+class ring
+{
+  public:
+    static constexpr std::size_t capacity{1 << 16};
+
+    ring(std::size_t threadId) : threadId_{threadId}, events_{new event[capacity]}
+    {
+    }
+
+    void push(event_type type, void const *address)
+    {
+        auto head = head_.load(std::memory_order_relaxed);
+        auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now().time_since_epoch())
+                             .count();
+        events_[head % capacity] = {timestamp, address, type};
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    std::size_t threadId_{};
+    // Guarded by the registry mutex.
+    std::string threadName_{};
+    std::atomic<std::uint64_t> head_{};
+    // Read by the flush only.
+    std::uint64_t tail_{};
+    std::unique_ptr<event[]> events_{};
+};
+
+/// @brief The class that represents the registry of the rings of all the threads, the rings outlive their threads.
+class registry
+{
+  public:
+    static registry &getInstance()
+    {
+        // Never destroyed, the workers may record the events during the exit.
+        static registry *instance = new registry{};
+        return *instance;
+    }
+
+    ring &local()
+    {
+        thread_local ring *local{};
+        if (nullptr == local)
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            rings_.push_back(std::make_unique<ring>(rings_.size() + 1));
+            local = rings_.back().get();
+        }
+
+        return *local;
+    }
+    /// @brief Names the current thread, the name is read by the flush.
+    void nameLocal(std::string name)
+    {
+        auto &ring = local();
+
+        std::lock_guard<std::mutex> lock{mutex_};
+        ring.threadName_ = std::move(name);
+    }
+
+    /// @brief Writes the events recorded since the previous flush as the Chrome trace JSON, to open in chrome://tracing
+    /// or Perfetto. The events being overwritten concurrently may be garbled, so it's better to flush when quiet.
+    void flush(std::ostream &out)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+
+        out << "{\"traceEvents\":[";
+        char const *separator = "";
+        for (auto &ring : rings_)
+        {
+            if (!ring->threadName_.empty())
+            {
+                out << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->threadId_
+                    << ",\"args\":{\"name\":\"" << ring->threadName_ << "\"}}";
+                separator = ",";
+            }
+
+            auto head = ring->head_.load(std::memory_order_acquire);
+            auto first = std::max(ring->tail_, head > ring::capacity ? head - ring::capacity : 0);
+            for (auto index = first; index < head; ++index)
+            {
+                auto const &traced = ring->events_[index % ring::capacity];
+                out << separator;
+                writeEvent(out, ring->threadId_, traced);
+                separator = ",";
+            }
+            ring->tail_ = head;
+        }
+        out << "]}" << std::endl;
+    }
+
+  private:
+    registry() = default;
+
+    static void writeEvent(std::ostream &out, std::size_t threadId, event const &traced)
+    {
+        // The begin and the end of the async slice should have the same name.
+        auto isLifetime = event_type::create == traced.type_ || event_type::destroy == traced.type_;
+        out << "{\"name\":\"" << (isLifetime ? "coroutine" : eventName(traced.type_))
+            << "\",\"cat\":\"coroutine\",\"pid\":1,\"tid\":" << threadId;
+        // The timestamps of the Chrome trace are in microseconds.
+        out << ",\"ts\":" << traced.timestamp_ / 1000 << '.' << std::setfill('0') << std::setw(3)
+            << traced.timestamp_ % 1000;
+
+        // The lifetime of the coroutine is the async slice with its instant events, the worker runs are the slices of
+        // the thread.
+        switch (traced.type_)
+        {
+        case event_type::create:
+            out << ",\"ph\":\"b\",\"id\":\"" << traced.address_ << "\"}";
+            break;
+        case event_type::destroy:
+            out << ",\"ph\":\"e\",\"id\":\"" << traced.address_ << "\"}";
+            break;
+        case event_type::slice_begin:
+            out << ",\"ph\":\"B\",\"args\":{\"coroutine\":\"" << traced.address_ << "\"}}";
+            break;
+        case event_type::slice_end:
+            out << ",\"ph\":\"E\"}";
+            break;
+        default:
+            out << ",\"ph\":\"n\",\"id\":\"" << traced.address_ << "\"}";
+            break;
+        }
+    }
+
+    std::mutex mutex_{};
+    std::vector<std::unique_ptr<ring>> rings_{};
+};
+
+/// @brief Records the event of the coroutine into the ring of the current thread.
+inline void record(event_type type, void const *address)
+{
+    registry::getInstance().local().push(type, address);
+}
+
+/// @brief Names the current thread in the trace.
+inline void nameThread(std::string name)
+{
+    registry::getInstance().nameLocal(std::move(name));
+}
+
+/// @brief Writes the events recorded since the previous flush as the Chrome trace JSON.
+inline void flush(std::ostream &out)
+{
+    registry::getInstance().flush(out);
+}
+
+/// @brief Writes the events recorded since the previous flush as the Chrome trace JSON file.
+inline void flush(std::string const &path)
+{
+    std::ofstream out{path};
+    flush(out);
+}
+
+/// @brief The class that represents the slice of the worker running the coroutine.
+class slice
+{
+  public:
+    slice(void const *address)
+    {
+        record(event_type::slice_begin, address);
+    }
+    ~slice()
+    {
+        record(event_type::slice_end, nullptr);
+    }
+};
+
+/// @brief The class that represents the initial awaiter of the traced coroutine, it records the first resume.
+class initial_awaiter
+{
+  public:
+    bool await_ready() noexcept
+    {
+        return false;
+    }
+    void await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        address_ = handle.address();
+    }
+    void await_resume() noexcept
+    {
+        record(event_type::first_resume, address_);
+    }
+
+  private:
+    void const *address_{};
+};
+} // namespace trace
+
+/// @brief The type that represents the initial awaiter of the async task.
+using initial_awaiter = trace::initial_awaiter;
+} // namespace coasyncpp
+
+#define COASYNCPP_TRACE(type, handle) ::coasyncpp::trace::record(::coasyncpp::trace::event_type::type, (handle).address())
+#define COASYNCPP_TRACE_SLICE(handle) ::coasyncpp::trace::slice traceSlice_{(handle).address()}
+#define COASYNCPP_TRACE_THREAD(name) ::coasyncpp::trace::nameThread(name)
+
+#else
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The type that represents the initial awaiter of the async task.
+using initial_awaiter = std::suspend_always;
+} // namespace coasyncpp
+
+#define COASYNCPP_TRACE(type, handle)
+#define COASYNCPP_TRACE_SLICE(handle)
+#define COASYNCPP_TRACE_THREAD(name)
+
+#endif
+
+#endif
@@ -0,0 +1,259 @@
+#ifndef __COASYNCPP_WINDOW_HPP__
+#define __COASYNCPP_WINDOW_HPP__
+
+#include "common.hpp"
+#include "scheduler.hpp"
+#include "async_generator.hpp"
+#include "stream.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The coroutine that notifies the signal on the Scheduler worker at the given time.
+inline detached_task notifyAt(std::shared_ptr<async_signal> signal, std::chrono::steady_clock::time_point at)
+{
+    co_await delayUntil(at);
+    signal->notify();
+}
+
+/// @brief The class that represents a timer which wakes up the stream stage at the deadline. It keeps at most one
+/// pending timer, so a later deadline is armed again only after the earlier timer fires.
+class stream_timer
+{
+  public:
+    stream_timer(std::shared_ptr<async_signal> signal) : signal_{std::move(signal)}
+    {
+    }
+
+    void arm(std::chrono::steady_clock::time_point at)
+    {
+        if (armedAt_ <= at && armedAt_ > std::chrono::steady_clock::now())
+            return;
+
+        armedAt_ = at;
+        notifyAt(signal_, at);
+    }
+
+  private:
+    std::shared_ptr<async_signal> signal_{};
+    std::chrono::steady_clock::time_point armedAt_{};
+};
+
+/// @brief The class that represents the single stream source of the windowing stage, running concurrently on the
+/// Scheduler, and the timer sharing its signal.
+/// @tparam T The type of the stream values.
+template <typename T> class stream_window
+{
+  public:
+    template <typename S>
+    stream_window(S source, std::size_t capacity) : streams_{std::make_shared<async_signal>()}, timer_{streams_.signal_}
+    {
+        streams_.open(std::move(source), capacity);
+    }
+
+    stream_channel<T> &channel()
+    {
+        return *streams_.channels_.front();
+    }
+    /// @brief Waits until the channel has a value, or is finished, or the deadline is over.
+    auto waitUntil(std::chrono::steady_clock::time_point at)
+    {
+        timer_.arm(at);
+        return streams_.signal_->wait(
+            [this, at]() { return channel().ready() || std::chrono::steady_clock::now() >= at; });
+    }
+    /// @brief Waits until the channel has a value or is finished.
+    auto wait()
+    {
+        return streams_.wait(channel());
+    }
+
+  private:
+    stream_channels<T> streams_;
+    stream_timer timer_;
+};
+
+/// @brief The coroutine that groups the values of the source into batches of the given count. The last batch may be
+/// smaller.
+/// @param source The parameter that represents the async generator to batch. It runs concurrently on the Scheduler.
+/// @param count The parameter that represents the count of values per batch. Should be greater then 0.
+/// @param capacity The parameter that represents the maximal count of values buffered ahead of the stage.
+template <typename S>
+async_generator<std::vector<stream_value_t<S>>> buffer_count(
+    S source, std::size_t count, std::size_t capacity = defaultStreamCapacity)
+{
+    assert(count > 0);
+
+    stream_window<stream_value_t<S>> window{std::move(source), capacity};
+    auto &channel = window.channel();
+
+    std::vector<stream_value_t<S>> batch{};
+    batch.reserve(count);
+    while (true)
+    {
+        stream_value_t<S> value{};
+        if (channel.tryPop(value))
+        {
+            batch.push_back(std::move(value));
+            if (batch.size() < count)
+                continue;
+        }
+        else if (channel.exhausted())
+            break;
+        else
+        {
+            co_await window.wait();
+            continue;
+        }
+
+        co_yield std::move(batch);
+        batch.clear();
+        batch.reserve(count);
+    }
+
+    if (!batch.empty())
+        co_yield std::move(batch);
+}
+
+/// @brief The coroutine that groups the values of the source into batches which are flushed when either the count of
+/// values or the time since the first value of the batch is reached, whichever comes first.
+/// @param source The parameter that represents the async generator to batch. It runs concurrently on the Scheduler.
+/// @param count The parameter that represents the maximal count of values per batch. Should be greater then 0.
+/// @param window The parameter that represents the maximal time a value waits in the batch.
+/// @param capacity The parameter that represents the maximal count of values buffered ahead of the stage.
+template <typename S>
+async_generator<std::vector<stream_value_t<S>>> buffer_time(S source, std::size_t count,
+    std::chrono::steady_clock::duration window, std::size_t capacity = defaultStreamCapacity)
+{
+    assert(count > 0);
+
+    stream_window<stream_value_t<S>> stream{std::move(source), capacity};
+    auto &channel = stream.channel();
+
+    std::vector<stream_value_t<S>> batch{};
+    std::chrono::steady_clock::time_point deadline{};
+    auto expired = [&batch, &deadline]() { return !batch.empty() && std::chrono::steady_clock::now() >= deadline; };
+
+    while (true)
+    {
+        stream_value_t<S> value{};
+        if (channel.tryPop(value))
+        {
+            if (batch.empty())
+                deadline = std::chrono::steady_clock::now() + window;
+
+            batch.push_back(std::move(value));
+            if (batch.size() < count && !expired())
+                continue;
+        }
+        else if (channel.exhausted())
+            break;
+        else if (!expired())
+        {
+            if (batch.empty())
+                co_await stream.wait();
+            else
+                co_await stream.waitUntil(deadline);
+            continue;
+        }
+
+        co_yield std::move(batch);
+        batch.clear();
+    }
+
+    if (!batch.empty())
+        co_yield std::move(batch);
+}
+
+/// @brief The coroutine that emits the value of the source only after the source was quiet for the given time. The
+/// values superseded within the time are dropped. The last value is emitted when the source is over.
+/// @param source The parameter that represents the async generator to debounce. It runs concurrently on the Scheduler.
+/// @param quiet The parameter that represents the time without new values before the latest value is emitted.
+/// @param capacity The parameter that represents the maximal count of values buffered ahead of the stage.
+template <typename S>
+async_generator<stream_value_t<S>> debounce(
+    S source, std::chrono::steady_clock::duration quiet, std::size_t capacity = defaultStreamCapacity)
+{
+    stream_window<stream_value_t<S>> stream{std::move(source), capacity};
+    auto &channel = stream.channel();
+
+    std::optional<stream_value_t<S>> pending{};
+    std::chrono::steady_clock::time_point deadline{};
+
+    while (true)
+    {
+        stream_value_t<S> value{};
+        if (channel.tryPop(value))
+        {
+            pending = std::move(value);
+            deadline = std::chrono::steady_clock::now() + quiet;
+        }
+        else if (channel.exhausted())
+            break;
+        else if (!pending)
+            co_await stream.wait();
+        else if (std::chrono::steady_clock::now() < deadline)
+            co_await stream.waitUntil(deadline);
+        else
+            co_yield std::exchange(pending, std::nullopt).value();
+    }
+
+    if (pending)
+        co_yield std::move(*pending);
+}
+
+/// @brief The coroutine that emits the latest value of the source once per period, if there was a new value within
+/// the period. The last value is emitted when the source is over.
+/// @param source The parameter that represents the async generator to sample. It runs concurrently on the Scheduler.
+/// @param period The parameter that represents the sampling period.
+/// @param capacity The parameter that represents the maximal count of values buffered ahead of the stage.
+template <typename S>
+async_generator<stream_value_t<S>> sample(
+    S source, std::chrono::steady_clock::duration period, std::size_t capacity = defaultStreamCapacity)
+{
+    assert(period > std::chrono::steady_clock::duration::zero());
+
+    stream_window<stream_value_t<S>> stream{std::move(source), capacity};
+    auto &channel = stream.channel();
+
+    std::optional<stream_value_t<S>> latest{};
+    auto tick = std::chrono::steady_clock::now() + period;
+
+    while (true)
+    {
+        if (auto now = std::chrono::steady_clock::now(); now >= tick)
+        {
+            // Skips the ticks missed while the consumer was busy.
+            while (tick <= now)
+                tick += period;
+
+            if (latest)
+                co_yield std::exchange(latest, std::nullopt).value();
+            continue;
+        }
+
+        stream_value_t<S> value{};
+        if (channel.tryPop(value))
+            latest = std::move(value);
+        else if (channel.exhausted())
+            break;
+        else if (latest)
+            co_await stream.waitUntil(tick);
+        else
+            co_await stream.wait();
+    }
+
+    if (latest)
+        co_yield std::move(*latest);
+}
+} // namespace coasyncpp
+
+#endif
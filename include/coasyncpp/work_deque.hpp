@@ -0,0 +1,137 @@
+#ifndef __COASYNCPP_WORK_DEQUE_HPP__
+#define __COASYNCPP_WORK_DEQUE_HPP__
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// @brief The namespace that represents classes/functions for async tasks manipulation.
+namespace coasyncpp
+{
+/// @brief The class that represents lock-free work stealing deque (Chase-Lev). The owner thread pushes and pops at the
+/// bottom, any other thread steals from the top.
+/// @tparam T The type of the items, should be trivially copyable, e.g. the coroutine address.
+template <typename T> class work_deque
+{
+  public:
+    work_deque(std::size_t capacity = 256) : array_{new array{std::bit_ceil(capacity)}}
+    {
+        arrays_.emplace_back(array_.load(std::memory_order_relaxed));
+    }
+    work_deque(work_deque const &) = delete;
+    work_deque &operator=(work_deque const &) = delete;
+
+    /// @brief Pushes the item at the bottom. Called by the owner thread only.
+    void push(T item)
+    {
+        auto bottom = bottom_.load(std::memory_order_relaxed);
+        auto top = top_.load(std::memory_order_acquire);
+        auto items = array_.load(std::memory_order_relaxed);
+
+        if (bottom - top >= static_cast<std::int64_t>(items->capacity()))
+            items = grow(items, top, bottom);
+
+        items->put(bottom, item);
+        bottom_.store(bottom + 1, std::memory_order_release);
+    }
+    /// @brief Pops the last pushed item from the bottom. Called by the owner thread only.
+    bool pop(T &item)
+    {
+        auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        auto items = array_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        item = items->get(bottom);
+        if (top == bottom)
+        {
+            // The last item, races with the thieves.
+            bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+
+        return true;
+    }
+    /// @brief Steals the first pushed item from the top. Called by any thread.
+    bool steal(T &item)
+    {
+        auto top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto bottom = bottom_.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+            return false;
+
+        item = array_.load(std::memory_order_acquire)->get(top);
+        return top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+    bool empty() const
+    {
+        return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+    }
+    /// @brief Returns the approximate count of the items, exact only for the owner thread.
+    std::size_t size() const
+    {
+        auto size = bottom_.load(std::memory_order_relaxed) - top_.load(std::memory_order_relaxed);
+        return size > 0 ? static_cast<std::size_t>(size) : 0;
+    }
+
+  private:
+    /// @brief The class that represents the circular array of the items.
+    class array
+    {
+      public:
+        array(std::size_t capacity) : mask_{capacity - 1}, items_{new std::atomic<T>[capacity]}
+        {
+        }
+
+        std::size_t capacity() const
+        {
+            return mask_ + 1;
+        }
+        T get(std::int64_t index) const
+        {
+            return items_[index & mask_].load(std::memory_order_relaxed);
+        }
+        void put(std::int64_t index, T item)
+        {
+            items_[index & mask_].store(item, std::memory_order_relaxed);
+        }
+
+      private:
+        std::size_t mask_{};
+        std::unique_ptr<std::atomic<T>[]> items_{};
+    };
+
+    array *grow(array *items, std::int64_t top, std::int64_t bottom)
+    {
+        auto grown = new array{2 * items->capacity()};
+        for (auto index = top; index < bottom; ++index)
+            grown->put(index, items->get(index));
+
+        // The thieves may still read the old array, so it's freed with the deque only.
+        arrays_.emplace_back(grown);
+        array_.store(grown, std::memory_order_release);
+
+        return grown;
+    }
+
+    alignas(64) std::atomic<std::int64_t> top_{};
+    alignas(64) std::atomic<std::int64_t> bottom_{};
+    std::atomic<array *> array_{};
+    std::vector<std::unique_ptr<array>> arrays_{};
+};
+} // namespace coasyncpp
+
+#endif